@@ -0,0 +1,35 @@
+#include <Tiny4kOLED.h>
+#include <Tiny4kOLED_DisplayList.h>
+// ============================================================================
+
+// Each primitive takes 9 bytes (on AVR), and rendering borrows a 128 byte
+// band buffer from the stack, one page at a time.
+DisplayListItem items[10];
+DisplayList displayList(items, 10);
+
+void setup() {
+  // put your setup code here, to run once:
+
+  oled.begin();
+  oled.on();
+  oled.switchRenderFrame();
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+
+  for (uint8_t r = 2; r < 16; r += 2) {
+    displayList.clear();
+    displayList.setDrawMode(DISPLAYLIST_SET);
+    displayList.rect(0, 0, 127, 31);
+    displayList.line(0, 31, 127, 0);
+    displayList.circle(96, 16, r);
+    displayList.setFont(FONT6X8);
+    displayList.text(4, 12, F("Datacute")); // y is in pixels, not pages
+    displayList.setDrawMode(DISPLAYLIST_INVERT);
+    displayList.fillRect(2, 10, 53, 21);
+    displayList.render(oled);
+    oled.switchFrame();
+    delay(200);
+  }
+}
@@ -0,0 +1,51 @@
+#include <Wire.h>
+#include <Tiny4kOLED.h>
+#include <Tiny4kOLED_DisplayList.h>
+#include <Tiny4kOLED_FrameFlusher.h>
+// ============================================================================
+// ESP32 only: two panels on each of the two hardware I2C buses.
+
+SSD1306_128x32 panel1(Wire, 0x3C);
+SSD1306_128x32 panel2(Wire, 0x3D);
+SSD1306_128x32 panel3(Wire1, 0x3C);
+SSD1306_128x32 panel4(Wire1, 0x3D);
+SSD1306_128x32 *panels[] = { &panel1, &panel2, &panel3, &panel4 };
+
+// one task per panel; panels sharing a bus take turns on it
+FrameFlusher flusher1(panel1, 0);
+FrameFlusher flusher2(panel2, 0);
+FrameFlusher flusher3(panel3, 1);
+FrameFlusher flusher4(panel4, 1);
+FrameFlusher *flushers[] = { &flusher1, &flusher2, &flusher3, &flusher4 };
+
+DisplayListItem items[4];
+DisplayList displayList(items, 4);
+
+void setup() {
+  // put your setup code here, to run once:
+
+  Wire.begin();
+  Wire1.begin(18, 19); // SDA, SCL of the second bus
+
+  for (uint8_t i = 0; i < 4; i++) {
+    panels[i]->begin();
+    panels[i]->clear();
+    panels[i]->on();
+    flushers[i]->begin();
+  }
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+
+  static uint8_t x = 0;
+  x = (x + 1) & 0x7F;
+  for (uint8_t i = 0; i < 4; i++) {
+    displayList.clear();
+    displayList.rect(0, 0, 127, 31);
+    displayList.vline((x + i * 32) & 0x7F, 0, 31);
+    // renders while the previous frame is still being sent
+    displayList.render(flushers[i]->frame(), 128, 4);
+    flushers[i]->flush(false);
+  }
+}
@@ -14,6 +14,7 @@
 // ----------------------------------------------------------------------------
 
 #include "Tiny4kOLED.h"
+#include "Tiny4kOLED_Transpose.h"
 
 #define SSD1306_COMMAND 0x00
 #define SSD1306_DATA 0x40
@@ -46,79 +47,278 @@ static const uint8_t ssd1306_init_sequence [] PROGMEM = {	// Initialization Sequ
 	0x8D, 0x14		// Set DC-DC enable
 };
 
-static const DCfont *oledFont = 0;
-static uint8_t oledX = 0, oledY = 0;
-
-static void ssd1306_send_start(uint8_t transmission_type) {
-	_WireClass.beginTransmission(SSD1306);
-	_WireClass.write(transmission_type);
-}
-
-static void ssd1306_send_stop(void) {
-	_WireClass.endTransmission();
+#if defined( ARDUINO_ARCH_ESP8266 ) || defined( ARDUINO_ARCH_ESP32 )
+#define _Wire (*wire)
+#else
+#define _Wire _WireClass
+#endif
+
+void SSD1306Device::ssd1306_send_start(uint8_t transmission_type) {
+	if (busFault && autoRecover) {
+		// drop transactions until the bus is back, rather than timing out on every one
+		transmitting = (this->*autoRecover)();
+		if (!transmitting) {
+			oledPointerKnown = false;
+			return;
+		}
+	}
+	_Wire.beginTransmission(address);
+	_Wire.write(transmission_type);
+	transmitting = true;
+}
+
+uint8_t SSD1306Device::ssd1306_send_stop(void) {
+	if (!transmitting)
+		return busFault;
+	transmitting = false;
+	uint8_t result = _Wire.endTransmission();
+	if (result) {
+		// who knows which of the transaction's bytes arrived
+		oledPointerKnown = false;
+		if (!busFault) busFault = result;
+	}
+	return result;
 }
 
-static void ssd1306_send_byte(uint8_t transmission_type, uint8_t byte) {
-	if (_WireClass.write(byte) == 0) {
+void SSD1306Device::ssd1306_send_byte(uint8_t transmission_type, uint8_t byte) {
+	if (transmission_type == SSD1306_DATA) {
+		// past column 127 the pointer returns to the column start address
+		if (oledPointerColumn == 0x7F) oledPointerKnown = false;
+		oledPointerColumn = (oledPointerColumn + 1) & 0x7F;
+	}
+	if (!transmitting)
+		return;
+	if (_Wire.write(byte) == 0) {
 		ssd1306_send_stop();
 		ssd1306_send_start(transmission_type);
-		_WireClass.write(byte);
+		if (transmitting)
+			_Wire.write(byte);
 	}
 }
 
-static void ssd1306_send_command(uint8_t command) {
+void SSD1306Device::ssd1306_send_command(uint8_t command) {
 	ssd1306_send_start(SSD1306_COMMAND);
-	_WireClass.write(command);
+	ssd1306_send_byte(SSD1306_COMMAND, command);
 	ssd1306_send_stop();
 }
 
-static void ssd1306_send_command2(uint8_t command1, uint8_t command2) {
+void SSD1306Device::ssd1306_send_command2(uint8_t command1, uint8_t command2) {
 	ssd1306_send_start(SSD1306_COMMAND);
-	_WireClass.write(command1);
-	_WireClass.write(command2);
+	ssd1306_send_byte(SSD1306_COMMAND, command1);
+	ssd1306_send_byte(SSD1306_COMMAND, command2);
 	ssd1306_send_stop();
 }
 
-static void ssd1306_send_command3(uint8_t command1, uint8_t command2, uint8_t command3) {
+void SSD1306Device::ssd1306_send_command3(uint8_t command1, uint8_t command2, uint8_t command3) {
 	ssd1306_send_start(SSD1306_COMMAND);
-	_WireClass.write(command1);
-	_WireClass.write(command2);
-	_WireClass.write(command3);
+	ssd1306_send_byte(SSD1306_COMMAND, command1);
+	ssd1306_send_byte(SSD1306_COMMAND, command2);
+	ssd1306_send_byte(SSD1306_COMMAND, command3);
 	ssd1306_send_stop();
 }
 
-static void ssd1306_send_command6(uint8_t command1, uint8_t command2, uint8_t command3, uint8_t command4, uint8_t command5, uint8_t command6) {
+void SSD1306Device::ssd1306_send_command4(uint8_t command1, uint8_t command2, uint8_t command3, uint8_t command4) {
 	ssd1306_send_start(SSD1306_COMMAND);
-	_WireClass.write(command1);
-	_WireClass.write(command2);
-	_WireClass.write(command3);
-	_WireClass.write(command4);
-	_WireClass.write(command5);
-	_WireClass.write(command6);
+	ssd1306_send_byte(SSD1306_COMMAND, command1);
+	ssd1306_send_byte(SSD1306_COMMAND, command2);
+	ssd1306_send_byte(SSD1306_COMMAND, command3);
+	ssd1306_send_byte(SSD1306_COMMAND, command4);
 	ssd1306_send_stop();
 }
 
-static void ssd1306_send_command7(uint8_t command1, uint8_t command2, uint8_t command3, uint8_t command4, uint8_t command5, uint8_t command6, uint8_t command7) {
+void SSD1306Device::ssd1306_send_command6(uint8_t command1, uint8_t command2, uint8_t command3, uint8_t command4, uint8_t command5, uint8_t command6) {
 	ssd1306_send_start(SSD1306_COMMAND);
-	_WireClass.write(command1);
-	_WireClass.write(command2);
-	_WireClass.write(command3);
-	_WireClass.write(command4);
-	_WireClass.write(command5);
-	_WireClass.write(command6);
-	_WireClass.write(command7);
+	ssd1306_send_byte(SSD1306_COMMAND, command1);
+	ssd1306_send_byte(SSD1306_COMMAND, command2);
+	ssd1306_send_byte(SSD1306_COMMAND, command3);
+	ssd1306_send_byte(SSD1306_COMMAND, command4);
+	ssd1306_send_byte(SSD1306_COMMAND, command5);
+	ssd1306_send_byte(SSD1306_COMMAND, command6);
 	ssd1306_send_stop();
 }
 
+void SSD1306Device::ssd1306_send_command7(uint8_t command1, uint8_t command2, uint8_t command3, uint8_t command4, uint8_t command5, uint8_t command6, uint8_t command7) {
+	ssd1306_send_start(SSD1306_COMMAND);
+	ssd1306_send_byte(SSD1306_COMMAND, command1);
+	ssd1306_send_byte(SSD1306_COMMAND, command2);
+	ssd1306_send_byte(SSD1306_COMMAND, command3);
+	ssd1306_send_byte(SSD1306_COMMAND, command4);
+	ssd1306_send_byte(SSD1306_COMMAND, command5);
+	ssd1306_send_byte(SSD1306_COMMAND, command6);
+	ssd1306_send_byte(SSD1306_COMMAND, command7);
+	ssd1306_send_stop();
+}
+
+// Release a slave holding SDA low, by clocking SCL until it lets go (at most
+// nine clocks, one byte and its ack), then make a STOP condition. The pins
+// are driven open drain: pulled low as outputs, released as inputs.
+static void ssd1306_release_bus(uint8_t sda, uint8_t scl) {
+	pinMode(sda, INPUT_PULLUP);
+	pinMode(scl, INPUT_PULLUP);
+	for (uint8_t i = 0; i < 9 && digitalRead(sda) == LOW; i++) {
+		digitalWrite(scl, LOW);
+		pinMode(scl, OUTPUT);
+		delayMicroseconds(5);
+		pinMode(scl, INPUT_PULLUP);
+		delayMicroseconds(5);
+	}
+	digitalWrite(sda, LOW);
+	pinMode(sda, OUTPUT);
+	delayMicroseconds(5);
+	pinMode(sda, INPUT_PULLUP);
+	delayMicroseconds(5);
+}
+
+void SSD1306Device::setBusTimeout(uint16_t timeoutMicros) {
+#if defined( ARDUINO_ARCH_ESP32 )
+	wire->setTimeOut((timeoutMicros + 999) / 1000);
+#elif defined( ARDUINO_ARCH_ESP8266 )
+	wire->setClockStretchLimit(timeoutMicros);
+#else
+	// TinyWire has no timeout
+	(void)timeoutMicros;
+#endif
+}
+
+void SSD1306Device::setBusPins(uint8_t sda, uint8_t scl) {
+	sdaPin = sda;
+	sclPin = scl;
+}
+
+bool SSD1306Device::recover(void) {
+	lastRecovery = millis();
+	if (sdaPin != SSD1306_NO_PIN) {
+		ssd1306_release_bus(sdaPin, sclPin);
+#if defined( ARDUINO_ARCH_ESP32 )
+		wire->end();
+#endif
+#if defined( ARDUINO_ARCH_ESP8266 ) || defined( ARDUINO_ARCH_ESP32 )
+		wire->begin(sdaPin, sclPin);
+#else
+		_Wire.begin();
+#endif
+	}
+	// the panel may have been reset too, so replay everything
+	busFault = 0;
+	ssd1306_send_start(SSD1306_COMMAND);
+	ssd1306_send_init_sequence();
+	ssd1306_send_state();
+	ssd1306_send_stop();
+	if (busFault)
+		return false;
+	recoveries++;
+	return true;
+}
+
+// installed by setAutoRecover(), so sketches that don't use it don't link recover()
+bool SSD1306Device::recoverIfDue(void) {
+	return millis() - lastRecovery >= SSD1306_RECOVERY_INTERVAL && recover();
+}
+
+// the state tracked since the init sequence, within a command transaction
+void SSD1306Device::ssd1306_send_state(void) {
+	ssd1306_send_byte(SSD1306_COMMAND, 0xDA);
+	ssd1306_send_byte(SSD1306_COMMAND, comPins);
+	ssd1306_send_byte(SSD1306_COMMAND, 0xD6);
+	ssd1306_send_byte(SSD1306_COMMAND, zoomed ? 0x01 : 0x00);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x81);
+	ssd1306_send_byte(SSD1306_COMMAND, contrast);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x8D);
+	ssd1306_send_byte(SSD1306_COMMAND, chargePumpEnabled ? 0x14 : 0x10);
+	ssd1306_send_byte(SSD1306_COMMAND, drawingFrame);
+	ssd1306_send_end_window();
+	ssd1306_send_byte(SSD1306_COMMAND, displayOn ? 0xAF : 0xAE);
+}
+
+// the number of bytes that follow a command, so operands aren't read as commands
+static uint8_t ssd1306_command_arguments(uint8_t command) {
+	switch (command) {
+		case 0x20: case 0x23: case 0x81: case 0x8D: case 0xA8:
+		case 0xD3: case 0xD5: case 0xD6: case 0xD9: case 0xDA: case 0xDB:
+			return 1;
+		case 0x21: case 0x22: case 0xA3:
+			return 2;
+		case 0x29: case 0x2A:
+			return 5;
+		case 0x26: case 0x27:
+			return 6;
+		default:
+			return 0;
+	}
+}
 
 void SSD1306Device::begin(uint8_t init_sequence_length, const uint8_t init_sequence []) {
-	_WireClass.begin();
+#if defined( ARDUINO_ARCH_ESP8266 ) || defined( ARDUINO_ARCH_ESP32 )
+	// other buses need their pins, so are begun by the sketch
+	if (wire == &Wire) {
+		wire->begin();
+	}
+#else
+	_Wire.begin();
+#endif
+	setBusTimeout(SSD1306_BUS_TIMEOUT);
+	oledPointerKnown = false;
+	initSequence = init_sequence;
+	initSequenceLength = init_sequence_length;
+	comPins = 0x12;
+	for (uint8_t i = 0; i < init_sequence_length; i++) {
+		uint8_t command = pgm_read_byte(&init_sequence[i]);
+		if (command == 0xDA && i + 1 < init_sequence_length) {
+			comPins = pgm_read_byte(&init_sequence[i + 1]);
+		}
+		i += ssd1306_command_arguments(command);
+	}
+
+	// fastBoot() sends the init sequence itself, along with more commands
+	if (booting)
+		return;
 
 	ssd1306_send_start(SSD1306_COMMAND);
-	for (uint8_t i = 0; i < init_sequence_length; i++) {
-		ssd1306_send_byte(SSD1306_COMMAND, pgm_read_byte(&init_sequence[i]));
+	ssd1306_send_init_sequence();
+	ssd1306_send_stop();
+}
+
+void SSD1306Device::ssd1306_send_init_sequence(void) {
+	for (uint8_t i = 0; i < initSequenceLength; i++) {
+		ssd1306_send_byte(SSD1306_COMMAND, pgm_read_byte(&initSequence[i]));
+	}
+}
+
+bool SSD1306Device::fastBoot(const uint8_t splash[]) {
+	booting = true;
+	begin();
+	booting = false;
+	busFault = 0;
+
+	// don't go any further if nothing acknowledges the address
+	_Wire.beginTransmission(address);
+	if (_Wire.endTransmission() != 0)
+		return false;
+
+	// on a 128x32 panel, clear the other frame too
+	uint8_t pages = offScreenRender() ? 8 : numberOfPages();
+	uint16_t splashLength = splash ? oledWidth() * numberOfPages() : 0;
+	uint16_t length = oledWidth() * pages;
+
+	ssd1306_send_start(SSD1306_COMMAND);
+	ssd1306_send_init_sequence();
+	ssd1306_send_window(0, 0, oledWidth() - 1, pages - 1, false);
+	ssd1306_send_stop();
+
+	startData();
+	for (uint16_t i = 0; i < length; i++) {
+		ssd1306_send_byte(SSD1306_DATA, i < splashLength ? pgm_read_byte(&splash[i]) : 0x00);
 	}
 	ssd1306_send_stop();
+
+	oledX = 0;
+	oledY = 0;
+	displayOn = true;
+	ssd1306_send_start(SSD1306_COMMAND);
+	ssd1306_send_end_window();
+	ssd1306_send_byte(SSD1306_COMMAND, 0xAF);
+	ssd1306_send_stop();
+	return busFault == 0;
 }
 
 void SSD1306Device::setFont(const DCfont *font) {
@@ -126,8 +326,29 @@ void SSD1306Device::setFont(const DCfont *font) {
 }
 
 void SSD1306Device::setCursor(uint8_t x, uint8_t y) {
-	int offsetX = x + oledXoffset();
-	ssd1306_send_command3(renderingFrame + (y & 0x07), 0x10 | ((offsetX & 0xf0) >> 4), offsetX & 0x0f);
+	uint8_t page = renderingFrame + (y & 0x07);
+	uint8_t column = (x + oledXoffset()) & 0x7F;
+	uint8_t commands[3], n = 0;
+	if (!oledPointerKnown || (page & 0x07) != oledPointerPage) {
+		commands[n++] = page;
+	}
+	// the nibble commands set the column start address register, not the
+	// pointer, so moving the column always needs both of them
+	if (!oledPointerKnown || column != oledPointerColumn) {
+		commands[n++] = 0x10 | (column >> 4);
+		commands[n++] = column & 0x0F;
+	}
+	bool sent = true;
+	if (n) {
+		ssd1306_send_start(SSD1306_COMMAND);
+		for (uint8_t i = 0; i < n; i++) {
+			ssd1306_send_byte(SSD1306_COMMAND, commands[i]);
+		}
+		sent = ssd1306_send_stop() == 0;
+	}
+	oledPointerPage = page & 0x07;
+	oledPointerColumn = column;
+	oledPointerKnown = sent;
 	oledX = x;
 	oledY = y;
 }
@@ -137,7 +358,7 @@ void SSD1306Device::clear(void) {
 }
 
 void SSD1306Device::fill(uint8_t fill) {
-	for (uint8_t m = 0; m < numberOfPages(); m++) {
+	for (uint8_t m = 0; m < visiblePages(); m++) {
 		fillLine(m, fill);
 	}
 	setCursor(0, 0);
@@ -149,10 +370,14 @@ void SSD1306Device::fillLine(uint8_t line, uint8_t fill)
 	fillToEOL(fill);
 }
 
+void SSD1306Device::setTextAttributes(uint8_t attributes) {
+	textAttributes = attributes;
+}
+
 void SSD1306Device::newLine(uint8_t fontHeight) {
 	oledY+=fontHeight;
-	if (oledY > numberOfPages() - fontHeight) {
-		oledY = numberOfPages() - fontHeight;
+	if (oledY > visiblePages() - fontHeight) {
+		oledY = visiblePages() - fontHeight;
 	}
 	setCursor(0, oledY);
 }
@@ -167,6 +392,10 @@ size_t SSD1306Device::write(byte c) {
 
 	if (c == '\r')
 		return 1;
+
+	// unknown rotations are written unrotated
+	if (textRotation == TEXT_ROTATE_90 || textRotation == TEXT_ROTATE_270)
+		return writeRotated(c);
 	
 	uint8_t h = oledFont->height;
 
@@ -194,13 +423,14 @@ size_t SSD1306Device::write(byte c) {
 		newLine(h);
 	}
 
-	int offset = ((uint8_t)c - oledFont->first) * w * h;
+	uint16_t offset = DCfontGlyph(oledFont, c) * w * h;
 	uint8_t line = h;
 	do
 	{
-		ssd1306_send_start(SSD1306_DATA);
+		uint8_t page = h - line;
+		startData();
 		for (uint8_t i = 0; i < w; i++) {
-			ssd1306_send_byte(SSD1306_DATA, pgm_read_byte(&(oledFont->bitmap[offset++])));
+			ssd1306_send_byte(SSD1306_DATA, glyphByte(offset, i, page));
 		}
 		ssd1306_send_stop();
 		if (h == 1) {
@@ -219,23 +449,226 @@ size_t SSD1306Device::write(byte c) {
 	return 1;
 }
 
+// one byte of a glyph, with the text attributes applied
+uint8_t SSD1306Device::glyphByte(uint16_t offset, uint8_t column, uint8_t page) {
+	uint8_t w = oledFont->width, h = oledFont->height;
+	const uint8_t *bitmap = oledFont->bitmap + offset + page * w;
+	uint8_t bits = pgm_read_byte(&bitmap[column]);
+	if (textAttributes) {
+		// the underline is the bottom row, the strikethrough the middle row (rounded up)
+		uint8_t strikeRow = h * 4 - 1;
+		if ((textAttributes & TEXT_BOLD) && column > 0) bits |= pgm_read_byte(&bitmap[column - 1]);
+		if ((textAttributes & TEXT_UNDERLINE) && page == h - 1) bits |= 0x80;
+		if ((textAttributes & TEXT_STRIKETHROUGH) && page == (strikeRow >> 3)) bits |= 1 << (strikeRow & 0x07);
+		if (textAttributes & TEXT_INVERSE) bits = ~bits;
+	}
+	return bits;
+}
+
+// Rotated glyphs are sent in vertical addressing mode, through a window the
+// size of the character cell, so each one is a single data transaction.
+// A glyph w pixels wide becomes a cell ceil(w/8) pages tall and 8*height
+// columns wide. Characters advance down the pages (90) or up them (270).
+size_t SSD1306Device::writeRotated(byte c) {
+	uint8_t w = oledFont->width, h = oledFont->height;
+	uint8_t cellPages = (w + 7) >> 3;
+	uint8_t cellWidth = h * 8;
+	bool clockwise = textRotation == TEXT_ROTATE_90;
+
+	// there's no rotated clear to end of line
+	if (c == '\t')
+		return 1;
+
+	if (c == '\n') {
+		// lines advance left (90) or right (270)
+		if (clockwise) {
+			oledX = oledX >= cellWidth ? oledX - cellWidth : 0;
+			oledY = 0;
+		}
+		else {
+			if (oledX + cellWidth * 2 <= oledWidth()) oledX += cellWidth;
+			oledY = visiblePages() - cellPages;
+		}
+		return 1;
+	}
+
+	// wrap at the bottom (90) or top (270) of the screen
+	if (clockwise ? oledY + cellPages > visiblePages() : oledY > visiblePages() - cellPages) {
+		write('\n');
+	}
+
+	uint16_t offset = DCfontGlyph(oledFont, c) * w * h;
+	uint8_t cellRows = cellPages * 8;
+	uint8_t blank = (textAttributes & TEXT_INVERSE) ? 0xFF : 0x00;
+	setWindow(oledX, oledY, oledX + cellWidth - 1, oledY + cellPages - 1, true);
+	startData();
+	for (uint8_t x = 0; x < cellWidth; x++) {
+		// glyph row gy becomes this column; glyph column gx becomes row r of the cell
+		uint8_t gy = clockwise ? cellWidth - 1 - x : x;
+		uint8_t bit = 1 << (gy & 0x07);
+		for (uint8_t page = 0; page < cellPages; page++) {
+			uint8_t bits = 0;
+			for (uint8_t b = 0; b < 8; b++) {
+				uint8_t r = page * 8 + b;
+				uint8_t gx = clockwise ? r : cellRows - 1 - r;
+				uint8_t pixel = gx < w ? glyphByte(offset, gx, gy >> 3) & bit : blank & bit;
+				if (pixel) bits |= 1 << b;
+			}
+			ssd1306_send_byte(SSD1306_DATA, bits);
+		}
+	}
+	ssd1306_send_stop();
+
+	if (clockwise) {
+		oledY += cellPages;
+	}
+	else if (oledY >= cellPages) {
+		oledY -= cellPages;
+	}
+	else {
+		// past the top; wrap before the next character
+		oledY = 0xFF;
+	}
+	endWindow();
+	return 1;
+}
+
+void SSD1306Device::setTextRotation(uint8_t rotation) {
+	textRotation = rotation;
+}
+
 void SSD1306Device::bitmap(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const uint8_t bitmap[]) {
-	uint16_t j = 0;
- 	for (uint8_t y = y0; y < y1; y++) {
-		setCursor(x0,y);
-		ssd1306_send_start(SSD1306_DATA);
-		for (uint8_t x = x0; x < x1; x++) {
-			ssd1306_send_byte(SSD1306_DATA, pgm_read_byte(&bitmap[j++]));
+	uint16_t length = (x1 - x0) * (y1 - y0);
+	// the window wraps each page onto the next, so the whole bitmap is one data transaction
+	setWindow(x0, y0, x1 - 1, y1 - 1);
+	startData();
+	for (uint16_t j = 0; j < length; j++) {
+		ssd1306_send_byte(SSD1306_DATA, pgm_read_byte(&bitmap[j]));
+	}
+	ssd1306_send_stop();
+	oledX = 0;
+	oledY = 0;
+	endWindow();
+}
+
+void SSD1306Device::blit(uint8_t x0, uint8_t y0, uint8_t width, uint8_t height, const uint8_t image[]) {
+	blitRows(x0, y0, width, height, image, false);
+}
+
+void SSD1306Device::blit_P(uint8_t x0, uint8_t y0, uint8_t width, uint8_t height, const uint8_t image[]) {
+	blitRows(x0, y0, width, height, image, true);
+}
+
+// each 8x8 block of the image becomes 8 columns of a page
+void SSD1306Device::blitRows(uint8_t x0, uint8_t y0, uint8_t width, uint8_t height, const uint8_t image[], bool progmem) {
+	uint8_t stride = (width + 7) >> 3;
+	uint8_t pages = (height + 7) >> 3;
+	uint8_t rows[8], columns[8];
+
+	setWindow(x0, y0, x0 + width - 1, y0 + pages - 1);
+	startData();
+	for (uint8_t page = 0; page < pages; page++) {
+		const uint8_t *block = image + (uint16_t)page * 8 * stride;
+		uint8_t rowCount = height - page * 8 < 8 ? height - page * 8 : 8;
+		for (uint8_t b = 0; b < stride; b++, block++) {
+			for (uint8_t r = 0; r < 8; r++) {
+				const uint8_t *p = block + r * stride;
+				rows[r] = r >= rowCount ? 0x00 : progmem ? pgm_read_byte(p) : *p;
+			}
+			tiny4koled_transpose8x8(rows, columns);
+			uint8_t columnCount = width - b * 8 < 8 ? width - b * 8 : 8;
+			for (uint8_t c = 0; c < columnCount; c++) {
+				ssd1306_send_byte(SSD1306_DATA, columns[c]);
+			}
 		}
-		ssd1306_send_stop();
 	}
-	setCursor(0, 0);
+	ssd1306_send_stop();
+	oledX = 0;
+	oledY = 0;
+	endWindow();
+}
+
+void SSD1306Device::startData(void) {
+	if (activityListener) {
+		activityListener->activity();
+	}
+	ssd1306_send_start(SSD1306_DATA);
+}
+
+void SSD1306Device::sendData(const uint8_t data) {
+	ssd1306_send_byte(SSD1306_DATA, data);
+}
+
+bool SSD1306Device::endData(void) {
+	return ssd1306_send_stop() == 0;
+}
+
+void SSD1306Device::setWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool vertical) {
+	ssd1306_send_start(SSD1306_COMMAND);
+	ssd1306_send_window(x0, y0, x1, y1, vertical);
+	ssd1306_send_stop();
+}
+
+void SSD1306Device::endWindow(void) {
+	ssd1306_send_start(SSD1306_COMMAND);
+	ssd1306_send_end_window();
+	ssd1306_send_stop();
+}
+
+void SSD1306Device::startCommand(void) {
+	ssd1306_send_start(SSD1306_COMMAND);
+}
+
+void SSD1306Device::sendCommand(const uint8_t command) {
+	ssd1306_send_byte(SSD1306_COMMAND, command);
+}
+
+bool SSD1306Device::endCommand(void) {
+	return ssd1306_send_stop() == 0;
+}
+
+// the commands of setWindow(), within a command transaction
+void SSD1306Device::ssd1306_send_window(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool vertical) {
+	uint8_t page = renderingFrame & 0x07;
+	oledPointerKnown = false;
+	ssd1306_send_byte(SSD1306_COMMAND, 0x20);
+	ssd1306_send_byte(SSD1306_COMMAND, vertical ? 0x01 : 0x00);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x21);
+	ssd1306_send_byte(SSD1306_COMMAND, (x0 + oledXoffset()) & 0x7F);
+	ssd1306_send_byte(SSD1306_COMMAND, (x1 + oledXoffset()) & 0x7F);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x22);
+	ssd1306_send_byte(SSD1306_COMMAND, (page + y0) & 0x07);
+	ssd1306_send_byte(SSD1306_COMMAND, (page + y1) & 0x07);
+}
+
+// the commands of endWindow(), within a command transaction
+void SSD1306Device::ssd1306_send_end_window(void) {
+	// reset the window to the whole of GDDRAM as well, so page mode wraps normally
+	int offsetX = oledX + oledXoffset();
+	ssd1306_send_byte(SSD1306_COMMAND, 0x21);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x00);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x7F);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x22);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x00);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x07);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x20);
+	ssd1306_send_byte(SSD1306_COMMAND, 0x02);
+	ssd1306_send_byte(SSD1306_COMMAND, renderingFrame + (oledY & 0x07));
+	ssd1306_send_byte(SSD1306_COMMAND, 0x10 | ((offsetX & 0xf0) >> 4));
+	ssd1306_send_byte(SSD1306_COMMAND, offsetX & 0x0f);
+	oledPointerPage = (renderingFrame + oledY) & 0x07;
+	oledPointerColumn = offsetX & 0x7F;
+	oledPointerKnown = true;
+}
+
+void SSD1306Device::forgetAddressPointer(void) {
+	oledPointerKnown = false;
 }
 
 void SSD1306Device::clearToEOS()
 {
 	uint8_t popX = oledX, popY = oledY;
-	for (int y = popY; y < numberOfPages(); y++)
+	for (int y = popY; y < visiblePages(); y++)
 	{
 		setCursor(0, y);
 		clearToEOL();
@@ -254,7 +687,7 @@ void SSD1306Device::fillToEOL(uint8_t fill) {
 
 void SSD1306Device::fillLength(uint8_t fill, uint8_t length) {
 	oledX += length;
-	ssd1306_send_start(SSD1306_DATA);
+	startData();
 	do
 	{
 		ssd1306_send_byte(SSD1306_DATA, fill);
@@ -267,6 +700,7 @@ void SSD1306Device::fillLength(uint8_t fill, uint8_t length) {
 // 1. Fundamental Command Table
 
 void SSD1306Device::setContrast(uint8_t contrast) {
+	this->contrast = contrast;
 	ssd1306_send_command2(0x81,contrast);
 }
 
@@ -285,10 +719,12 @@ void SSD1306Device::setInverse(bool enable) {
 }
 
 void SSD1306Device::off(void) {
+	displayOn = false;
 	ssd1306_send_command(0xAE);
 }
 
 void SSD1306Device::on(void) {
+	displayOn = true;
 	ssd1306_send_command(0xAF);
 }
 
@@ -325,23 +761,28 @@ void SSD1306Device::setVerticalScrollArea(uint8_t top, uint8_t rows) {
 // 3. Addressing Setting Command Table
 
 void SSD1306Device::setColumnStartAddress(uint8_t startAddress) {
-	ssd1306_send_command2(startAddress & 0x0F, startAddress >> 4);
+	ssd1306_send_command2(startAddress & 0x0F, 0x10 | ((startAddress >> 4) & 0x07));
+	oledPointerColumn = startAddress & 0x7F;
 }
 
 void SSD1306Device::setMemoryAddressingMode(uint8_t mode) {
 	ssd1306_send_command2(0x20, mode & 0x03);
+	oledPointerKnown = false;
 }
 
 void SSD1306Device::setColumnAddress(uint8_t startAddress, uint8_t endAddress) {
 	ssd1306_send_command3(0x21, startAddress & 0x7F, endAddress & 0x7F);
+	oledPointerKnown = false;
 }
 
 void SSD1306Device::setPageAddress(uint8_t startPage, uint8_t endPage) {
 	ssd1306_send_command3(0x22, startPage & 0x07, endPage & 0x07);
+	oledPointerKnown = false;
 }
 
 void SSD1306Device::setPageStartAddress(uint8_t startPage) {
 	ssd1306_send_command(0xB0 | (startPage & 0x07));
+	oledPointerPage = startPage & 0x07;
 }
 
 // 4. Hardware Configuration (Panel resolution and layout related) Command Table
@@ -367,7 +808,8 @@ void SSD1306Device::setDisplayOffset(uint8_t offset) {
 }
 
 void SSD1306Device::setComPinsHardwareConfiguration(uint8_t alternative, uint8_t enableLeftRightRemap) {
-	ssd1306_send_command2(0xDA, ((enableLeftRightRemap & 0x01) << 5) | ((alternative & 0x01) << 4) | 0x02 );
+	comPins = ((enableLeftRightRemap & 0x01) << 5) | ((alternative & 0x01) << 4) | 0x02;
+	ssd1306_send_command2(0xDA, comPins);
 }
 
 // 5. Timing and Driving Scheme Setting Command table
@@ -403,20 +845,39 @@ void SSD1306Device::disableFadeOutAndBlinking(void) {
 }
 
 void SSD1306Device::enableZoomIn(void) {
+	zoomed = true;
 	ssd1306_send_command2(0xD6, 0x01);
 }
 
 void SSD1306Device::disableZoomIn(void) {
+	zoomed = false;
 	ssd1306_send_command2(0xD6, 0x00);
 }
 
+// Zoom only doubles each GDDRAM row onto adjacent rows of the panel when
+// the alternative COM pin configuration is selected. Panels wired for the
+// sequential configuration (128x32) then show row r from GDDRAM row r/2,
+// as do panels wired for the alternative one, so both get the same layout:
+// the top half of the frame, with pages 0 to visiblePages()-1.
+void SSD1306Device::enableLargeText(void) {
+	zoomed = true;
+	ssd1306_send_command4(0xDA, comPins | 0x10, 0xD6, 0x01);
+}
+
+void SSD1306Device::disableLargeText(void) {
+	zoomed = false;
+	ssd1306_send_command4(0xD6, 0x00, 0xDA, comPins);
+}
+
 // Charge Pump Settings
 
 void SSD1306Device::enableChargePump(void) {
+	chargePumpEnabled = true;
 	ssd1306_send_command2(0x8D, 0x14);
 }
 
 void SSD1306Device::disableChargePump(void) {
+	chargePumpEnabled = false;
 	ssd1306_send_command2(0x8D, 0x10);
 }
 
@@ -463,5 +924,7 @@ void SSD1306_64x48::begin(void) {
 	SSD1306Device::begin(sizeof(SSD1306_64x48_init_sequence), SSD1306_64x48_init_sequence);
 
 	renderingFrame = 0xb2;
+	// the start line the init sequence sets, for recover() to replay
+	drawingFrame = 0x50;
 }
 
@@ -28,8 +28,17 @@ typedef struct {
 	uint8_t width;        // character width in pixels
 	uint8_t height;       // character height in pages (8 pixels)
 	uint8_t first, last;  // ASCII extents
+	const uint8_t *remap; // optional PROGMEM glyph index per character, for subset fonts
 } DCfont;
 
+// the glyph number of character c; characters outside the font's extents get glyph 0
+static inline uint8_t DCfontGlyph(const DCfont *font, uint8_t c) {
+	if (c < font->first || c > font->last)
+		return 0;
+	c -= font->first;
+	return font->remap ? pgm_read_byte(&(font->remap[c])) : c;
+}
+
 // Two included fonts, The space isn't used unless it is needed
 #include "font6x8.h"
 #include "font8x16.h"
@@ -42,6 +51,41 @@ typedef struct {
 
 // ----------------------------------------------------------------------------
 
+// Bus fault handling
+#ifndef SSD1306_BUS_TIMEOUT
+#define SSD1306_BUS_TIMEOUT			25000	// microseconds, on ESP8266 and ESP32
+#endif
+#ifndef SSD1306_RECOVERY_INTERVAL
+#define SSD1306_RECOVERY_INTERVAL	1000	// milliseconds between automatic recovery attempts
+#endif
+#define SSD1306_NO_PIN				0xFF
+
+// ----------------------------------------------------------------------------
+
+// Text attributes, applied to each glyph as write() sends it
+#define TEXT_NORMAL			0x00
+#define TEXT_INVERSE		0x01	// XOR the whole character cell
+#define TEXT_UNDERLINE		0x02	// bottom row of the last page
+#define TEXT_STRIKETHROUGH	0x04	// middle row
+#define TEXT_BOLD			0x08	// OR with the glyph shifted right a column
+
+// Text rotation, for portrait mounted panels. The cursor is the top left of
+// the next character cell, whose height is rounded up to whole pages.
+// Rotated text ignores '\t', rather than clearing to the end of the line.
+#define TEXT_ROTATE_0		0
+#define TEXT_ROTATE_90		1	// reads top to bottom, lines advance right to left
+#define TEXT_ROTATE_270		3	// reads bottom to top, lines advance left to right
+
+// ----------------------------------------------------------------------------
+
+// Notified at the start of every data transaction, e.g. to wake a dimmed display
+class SSD1306ActivityListener {
+	public:
+		virtual void activity(void) = 0;
+};
+
+// ----------------------------------------------------------------------------
+
 class SSD1306Device: public Print {
 
 protected:
@@ -49,11 +93,33 @@ protected:
 
 
 	public:
+		SSD1306Device(void) {}
+		// a second panel on the same bus, with its address set to 0x3D
+		SSD1306Device(uint8_t address) : address(address) {}
+#if defined( ARDUINO_ARCH_ESP8266 ) || defined( ARDUINO_ARCH_ESP32 )
+		// a panel on another bus, e.g. Wire1, which the sketch must begin() with its pins first.
+		// Only Wire's pins are known, so recover() needs setBusPins() for other buses.
+		SSD1306Device(TwoWire &wire, uint8_t address = SSD1306) : wire(&wire), address(address) {
+			if (&wire != &Wire) {
+				sdaPin = SSD1306_NO_PIN;
+				sclPin = SSD1306_NO_PIN;
+			}
+		}
+#endif
+
 		// begin by calling the protected begin(...) with yuor init
 		virtual void begin(void)=0;
+		// begin(), clear all of GDDRAM (both frames of a 128x32), show an optional
+		// full screen splash bitmap, and turn the display on, in three transactions.
+		// Returns false straight away if the panel doesn't acknowledge its address.
+		bool fastBoot(const uint8_t splash[] = 0);
 
 		void setFont(const DCfont *font);
+		void setTextAttributes(uint8_t attributes);
+		void setTextRotation(uint8_t rotation);
 		virtual void setCursor(uint8_t x, uint8_t y);
+		uint8_t cursorX(void) { return oledX; }
+		uint8_t cursorY(void) { return oledY; }
 		void newLine();
 		void fill(uint8_t fill);
 		void fillLine(uint8_t line, uint8_t fill);
@@ -63,8 +129,31 @@ protected:
 		void clearToEOL(void);
 		void clearToEOS();
 		void bitmap(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const uint8_t bitmap[]);
+		// row-major images, 1 bit per pixel with the leftmost pixel in the most
+		// significant bit and each row padded to whole bytes (PBM, GFX drawBitmap()),
+		// transposed to page layout as they are sent. x0 is in pixels, y0 in pages.
+		void blit(uint8_t x0, uint8_t y0, uint8_t width, uint8_t height, const uint8_t image[]);
+		void blit_P(uint8_t x0, uint8_t y0, uint8_t width, uint8_t height, const uint8_t image[]);
+
+		// raw data transactions, for renderers outside this class
+		void startData(void);
+		void sendData(const uint8_t data);
+		// true if the panel acknowledged the whole transaction
+		bool endData(void);
+		// raw command transactions, for batching several commands together
+		void startCommand(void);
+		void sendCommand(const uint8_t command);
+		bool endCommand(void);
+		// restrict data writes to columns x0..x1 and pages y0..y1 (horizontal, or vertical, addressing)
+		void setWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool vertical = false);
+		// return to page addressing, with the controller pointing at the cursor
+		void endWindow(void);
+		// call after sending raw commands that move the GDDRAM address pointer
+		void forgetAddressPointer(void);
 		// the number of rows/8
 		virtual uint8_t numberOfPages() = 0;
+		// the pages text and fills use; half of them with large text
+		uint8_t visiblePages() { return zoomed ? numberOfPages() >> 1 : numberOfPages(); }
 		// if the screen is smaller than 128, this is the offset from left, of screen memory
 		virtual uint8_t oledXoffset() { return 0;  }
 		// how wide the PHYSICAL screen is
@@ -77,6 +166,8 @@ protected:
 		virtual uint8_t currentRenderFrame(void) { return 1; }
 		virtual uint8_t currentDisplayFrame(void) { return 1; }
 		virtual bool offScreenRender() { return false; }
+		// the GDDRAM page that cursor page 0 is in
+		uint8_t firstRenderPage(void) { return renderingFrame & 0x07; }
 
 		// 1. Fundamental Command Table
 
@@ -85,6 +176,30 @@ protected:
 		void setInverse(bool enable);
 		void off(void);
 		void on(void);
+		// the state last sent by setContrast(), on()/off() and enable/disableChargePump()
+		uint8_t currentContrast(void) { return contrast; }
+		bool isDisplayOn(void) { return displayOn; }
+		bool isChargePumpEnabled(void) { return chargePumpEnabled; }
+		void setActivityListener(SSD1306ActivityListener *listener) { activityListener = listener; }
+
+		// Bus faults. busError() is the first non zero endTransmission() result
+		// since clearBusError(), fastBoot() or a successful recover().
+		uint8_t busError(void) { return busFault; }
+		void clearBusError(void) { busFault = 0; }
+		// begin() sets SSD1306_BUS_TIMEOUT on ESP8266 and ESP32. TinyWire (ATtiny85)
+		// has no timeout, so there nothing bounds a transaction while SCL is held low.
+		void setBusTimeout(uint16_t timeoutMicros);
+		// the pins recover() clocks, if not the board's SDA and SCL, e.g. for Wire1
+		void setBusPins(uint8_t sda, uint8_t scl);
+		// free a stuck bus, then replay the init sequence and the tracked state:
+		// COM pins, zoom, contrast, charge pump, display frame, cursor and on/off.
+		// Returns false if the panel still doesn't respond.
+		bool recover(void);
+		// after a fault, drop transactions, trying recover() before the next one
+		// at most every SSD1306_RECOVERY_INTERVAL ms
+		void setAutoRecover(bool enable) { autoRecover = enable ? &SSD1306Device::recoverIfDue : 0; }
+		// successful recoveries so far; what was drawn during a fault needs redrawing
+		uint8_t recoveryCount(void) { return recoveries; }
 
 		// 2. Scrolling Command Table
 
@@ -126,6 +241,9 @@ protected:
 		void disableFadeOutAndBlinking(void);
 		void enableZoomIn(void);
 		void disableZoomIn(void);
+		// zoom in, with the COM pin configuration zoom needs, so text is double height
+		void enableLargeText(void);
+		void disableLargeText(void);
 
 		// Charge Pump Settings
 
@@ -138,9 +256,64 @@ protected:
 protected:
 
 	uint8_t renderingFrame = 0xB0, drawingFrame = 0x40;
+	// reset values, except the charge pump which every init sequence enables
+	uint8_t contrast = 0x7F;
+	bool displayOn = false, chargePumpEnabled = true;
+	SSD1306ActivityListener *activityListener = 0;
+
+#if defined( ARDUINO_ARCH_ESP8266 ) || defined( ARDUINO_ARCH_ESP32 )
+	TwoWire *wire = &Wire;
+#endif
+	uint8_t address = SSD1306;
+	uint8_t busFault = 0;
+	bool transmitting = false;
+	bool (SSD1306Device::*autoRecover)(void) = 0;
+	uint8_t recoveries = 0;
+	unsigned long lastRecovery = 0;
+#if defined( ARDUINO_ARCH_ESP8266 ) || defined( ARDUINO_ARCH_ESP32 )
+	uint8_t sdaPin = SDA, sclPin = SCL;
+#elif defined( PIN_WIRE_SDA ) && defined( PIN_WIRE_SCL )
+	uint8_t sdaPin = PIN_WIRE_SDA, sclPin = PIN_WIRE_SCL;
+#else
+	uint8_t sdaPin = SSD1306_NO_PIN, sclPin = SSD1306_NO_PIN;
+#endif
+	const uint8_t *initSequence = 0;
+	uint8_t initSequenceLength = 0;
+	bool booting = false;
+	// COM pins hardware configuration from the init sequence (0x12 is the reset value)
+	uint8_t comPins = 0x12;
+	bool zoomed = false;
+	const DCfont *oledFont = 0;
+	uint8_t oledX = 0, oledY = 0;
+	uint8_t textAttributes = TEXT_NORMAL;
+	uint8_t textRotation = TEXT_ROTATE_0;
+
+	// Where the controller's GDDRAM address pointer is, so that setCursor() can
+	// skip a page or column that's already right. Data writes in page addressing
+	// mode advance the column; a write past column 127 makes it unknown.
+	uint8_t oledPointerColumn = 0, oledPointerPage = 0;
+	bool oledPointerKnown = false;
+
+		void ssd1306_send_start(uint8_t transmission_type);
+		uint8_t ssd1306_send_stop(void);
+		void ssd1306_send_byte(uint8_t transmission_type, uint8_t byte);
+		void ssd1306_send_command(uint8_t command);
+		void ssd1306_send_command2(uint8_t command1, uint8_t command2);
+		void ssd1306_send_command3(uint8_t command1, uint8_t command2, uint8_t command3);
+		void ssd1306_send_command4(uint8_t command1, uint8_t command2, uint8_t command3, uint8_t command4);
+		void ssd1306_send_command6(uint8_t command1, uint8_t command2, uint8_t command3, uint8_t command4, uint8_t command5, uint8_t command6);
+		void ssd1306_send_command7(uint8_t command1, uint8_t command2, uint8_t command3, uint8_t command4, uint8_t command5, uint8_t command6, uint8_t command7);
+		void ssd1306_send_init_sequence(void);
+		void ssd1306_send_window(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool vertical);
+		void ssd1306_send_end_window(void);
+		void ssd1306_send_state(void);
+		bool recoverIfDue(void);
 
 	private:
 		void newLine(uint8_t fontHeight);
+		uint8_t glyphByte(uint16_t offset, uint8_t column, uint8_t page);
+		size_t writeRotated(byte c);
+		void blitRows(uint8_t x0, uint8_t y0, uint8_t width, uint8_t height, const uint8_t image[], bool progmem);
 
 };
 
@@ -173,6 +346,7 @@ const uint8_t SSD1306_128x32_init_sequence[] PROGMEM = {
 class SSD1306_128x32 : public SSD1306Device
 {
 public:
+	using SSD1306Device::SSD1306Device;
 
 	virtual void begin();
 	virtual uint8_t numberOfPages() { return 4; }
@@ -206,6 +380,7 @@ const uint8_t SSD1306_128x64_init_sequence[] PROGMEM = {
 class SSD1306_128x64 : public SSD1306Device
 {
 public:
+	using SSD1306Device::SSD1306Device;
 
 	virtual void begin();
 	virtual uint8_t numberOfPages() { return 8; }
@@ -234,6 +409,7 @@ const uint8_t SSD1306_64x48_init_sequence[] PROGMEM = {
 class SSD1306_64x48 : public SSD1306Device
 {
 public:
+	using SSD1306Device::SSD1306Device;
 
 	virtual void begin();
 	virtual uint8_t numberOfPages() { return 6; }
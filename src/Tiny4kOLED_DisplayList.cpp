@@ -0,0 +1,295 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+
+// ----------------------------------------------------------------------------
+
+#include "Tiny4kOLED_DisplayList.h"
+
+#define DL_PIXEL		1
+#define DL_HLINE		2
+#define DL_VLINE		3
+#define DL_LINE			4
+#define DL_RECT			5
+#define DL_FILLRECT		6
+#define DL_CIRCLE		7
+#define DL_FILLCIRCLE	8
+#define DL_TEXT			9
+#define DL_TEXT_P		10
+
+#define DL_TYPE_MASK	0x3F
+#define DL_MODE_MASK	0xC0
+
+// ----------------------------------------------------------------------------
+
+static void dl_apply(uint8_t *b, uint8_t mask, uint8_t mode) {
+	if (mode == DISPLAYLIST_CLEAR)
+		*b &= ~mask;
+	else if (mode == DISPLAYLIST_INVERT)
+		*b ^= mask;
+	else
+		*b |= mask;
+}
+
+// bits of the band covered by pixel rows y0..y1
+static uint8_t dl_span_mask(int16_t y0, int16_t y1, uint8_t top) {
+	y0 -= top;
+	y1 -= top;
+	if (y1 < 0 || y0 > 7 || y0 > y1) return 0;
+	if (y0 < 0) y0 = 0;
+	if (y1 > 7) y1 = 7;
+	return (uint8_t)(0xFF << y0) & (uint8_t)(0xFF >> (7 - y1));
+}
+
+static void dl_columns(uint8_t *band, uint8_t width, int16_t x0, int16_t x1, uint8_t mask, uint8_t mode) {
+	if (!mask) return;
+	if (x0 < 0) x0 = 0;
+	if (x1 >= width) x1 = width - 1;
+	for (int16_t x = x0; x <= x1; x++) {
+		dl_apply(&band[x], mask, mode);
+	}
+}
+
+static void dl_plot(uint8_t *band, uint8_t width, uint8_t top, int16_t x, int16_t y, uint8_t mode) {
+	if (x < 0 || x >= width) return;
+	y -= top;
+	if (y < 0 || y > 7) return;
+	dl_apply(&band[x], 1 << y, mode);
+}
+
+// ----------------------------------------------------------------------------
+
+DisplayList::DisplayList(DisplayListItem *items, uint8_t capacity) :
+	items(items), capacity(capacity) {
+}
+
+void DisplayList::clear(void) {
+	itemCount = 0;
+}
+
+void DisplayList::setDrawMode(uint8_t mode) {
+	drawMode = mode & DL_MODE_MASK;
+}
+
+void DisplayList::setFont(const DCfont *font) {
+	this->font = font;
+}
+
+bool DisplayList::add(uint8_t type, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const void *text) {
+	if (itemCount >= capacity)
+		return false;
+	DisplayListItem *item = &items[itemCount++];
+	item->type = type | drawMode;
+	item->x0 = x0;
+	item->y0 = y0;
+	item->x1 = x1;
+	item->y1 = y1;
+	item->text = text;
+	item->font = font;
+	return true;
+}
+
+bool DisplayList::pixel(uint8_t x, uint8_t y) {
+	return add(DL_PIXEL, x, y, x, y, 0);
+}
+
+bool DisplayList::hline(uint8_t x0, uint8_t y, uint8_t x1) {
+	if (x0 > x1) { uint8_t t = x0; x0 = x1; x1 = t; }
+	return add(DL_HLINE, x0, y, x1, y, 0);
+}
+
+bool DisplayList::vline(uint8_t x, uint8_t y0, uint8_t y1) {
+	if (y0 > y1) { uint8_t t = y0; y0 = y1; y1 = t; }
+	return add(DL_VLINE, x, y0, x, y1, 0);
+}
+
+bool DisplayList::line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+	return add(DL_LINE, x0, y0, x1, y1, 0);
+}
+
+bool DisplayList::rect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+	if (x0 > x1) { uint8_t t = x0; x0 = x1; x1 = t; }
+	if (y0 > y1) { uint8_t t = y0; y0 = y1; y1 = t; }
+	return add(DL_RECT, x0, y0, x1, y1, 0);
+}
+
+bool DisplayList::fillRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+	if (x0 > x1) { uint8_t t = x0; x0 = x1; x1 = t; }
+	if (y0 > y1) { uint8_t t = y0; y0 = y1; y1 = t; }
+	return add(DL_FILLRECT, x0, y0, x1, y1, 0);
+}
+
+bool DisplayList::circle(uint8_t x, uint8_t y, uint8_t r) {
+	return add(DL_CIRCLE, x, y, r, r, 0);
+}
+
+bool DisplayList::fillCircle(uint8_t x, uint8_t y, uint8_t r) {
+	return add(DL_FILLCIRCLE, x, y, r, r, 0);
+}
+
+bool DisplayList::text(uint8_t x, uint8_t y, const char *s) {
+	if (!font) return false;
+	return add(DL_TEXT, x, y, 0, 0, s);
+}
+
+bool DisplayList::text(uint8_t x, uint8_t y, const __FlashStringHelper *s) {
+	if (!font) return false;
+	return add(DL_TEXT_P, x, y, 0, 0, s);
+}
+
+void DisplayList::render(SSD1306Device &device) {
+	uint8_t band[128];
+	uint8_t width = device.oledWidth();
+	uint8_t pages = device.visiblePages();
+
+	device.setWindow(0, 0, width - 1, pages - 1);
+	for (uint8_t page = 0; page < pages; page++) {
+		uint8_t top = page * 8;
+		memset(band, 0, width);
+		for (uint8_t i = 0; i < itemCount; i++) {
+			renderItem(&items[i], band, width, top);
+		}
+		device.startData();
+		for (uint8_t x = 0; x < width; x++) {
+			device.sendData(band[x]);
+		}
+		device.endData();
+	}
+	device.endWindow();
+}
+
+void DisplayList::render(uint8_t *frame, uint8_t width, uint8_t pages) {
+	for (uint8_t page = 0; page < pages; page++) {
+		uint8_t *band = frame + page * width;
+		memset(band, 0, width);
+		for (uint8_t i = 0; i < itemCount; i++) {
+			renderItem(&items[i], band, width, page * 8);
+		}
+	}
+}
+
+void DisplayList::renderItem(const DisplayListItem *item, uint8_t *band, uint8_t width, uint8_t top) {
+	uint8_t mode = item->type & DL_MODE_MASK;
+	int16_t x0 = item->x0, y0 = item->y0, x1 = item->x1, y1 = item->y1;
+
+	switch (item->type & DL_TYPE_MASK) {
+		case DL_PIXEL:
+			dl_plot(band, width, top, x0, y0, mode);
+			break;
+
+		case DL_HLINE:
+		case DL_VLINE:
+		case DL_FILLRECT:
+			dl_columns(band, width, x0, x1, dl_span_mask(y0, y1, top), mode);
+			break;
+
+		case DL_RECT:
+			// each pixel is touched once, so inverting works
+			dl_columns(band, width, x0, x1, dl_span_mask(y0, y0, top), mode);
+			if (y1 != y0)
+				dl_columns(band, width, x0, x1, dl_span_mask(y1, y1, top), mode);
+			dl_columns(band, width, x0, x0, dl_span_mask(y0 + 1, y1 - 1, top), mode);
+			if (x1 != x0)
+				dl_columns(band, width, x1, x1, dl_span_mask(y0 + 1, y1 - 1, top), mode);
+			break;
+
+		case DL_LINE: {
+			if ((y0 < top && y1 < top) || (y0 > top + 7 && y1 > top + 7))
+				break;
+			int16_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+			int16_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+			int16_t err = dx + dy;
+			for (;;) {
+				dl_plot(band, width, top, x0, y0, mode);
+				if (x0 == x1 && y0 == y1) break;
+				int16_t e2 = 2 * err;
+				if (e2 >= dy) { err += dy; x0 += sx; }
+				if (e2 <= dx) { err += dx; y0 += sy; }
+			}
+			break;
+		}
+
+		case DL_CIRCLE: {
+			if (y0 + x1 < top || y0 - x1 > top + 7)
+				break;
+			// midpoint circle, skipping points shared between octants
+			int16_t x = x1, y = 0, err = 1 - x1;
+			while (x >= y) {
+				dl_plot(band, width, top, x0 + x, y0 + y, mode);
+				dl_plot(band, width, top, x0 - x, y0 - y, mode);
+				if (y != 0) {
+					dl_plot(band, width, top, x0 + x, y0 - y, mode);
+					dl_plot(band, width, top, x0 - x, y0 + y, mode);
+				}
+				if (x != y) {
+					dl_plot(band, width, top, x0 + y, y0 + x, mode);
+					dl_plot(band, width, top, x0 - y, y0 - x, mode);
+					if (y != 0) {
+						dl_plot(band, width, top, x0 - y, y0 + x, mode);
+						dl_plot(band, width, top, x0 + y, y0 - x, mode);
+					}
+				}
+				y++;
+				if (err < 0) {
+					err += 2 * y + 1;
+				}
+				else {
+					x--;
+					err += 2 * (y - x) + 1;
+				}
+			}
+			break;
+		}
+
+		case DL_FILLCIRCLE: {
+			if (y0 + x1 < top || y0 - x1 > top + 7)
+				break;
+			// one vertical span per column
+			int16_t r2 = x1 * x1 + x1, h = x1;
+			for (int16_t x = 0; x <= x1; x++) {
+				while (h > 0 && x * x + h * h > r2) h--;
+				uint8_t mask = dl_span_mask(y0 - h, y0 + h, top);
+				dl_columns(band, width, x0 + x, x0 + x, mask, mode);
+				if (x != 0)
+					dl_columns(band, width, x0 - x, x0 - x, mask, mode);
+			}
+			break;
+		}
+
+		case DL_TEXT:
+		case DL_TEXT_P: {
+			const DCfont *f = item->font;
+			uint8_t w = f->width, h = f->height;
+			if (y0 + h * 8 <= top || y0 > top + 7)
+				break;
+			const char *s = (const char *)item->text;
+			bool progmem = (item->type & DL_TYPE_MASK) == DL_TEXT_P;
+			int16_t x = x0;
+			for (;;) {
+				uint8_t c = progmem ? pgm_read_byte(s) : *s;
+				s++;
+				if (c == 0 || x >= width) break;
+				if (c < f->first || c > f->last) {
+					x += w;
+					continue;
+				}
+				uint16_t offset = (uint16_t)DCfontGlyph(f, c) * w * h;
+				for (uint8_t row = 0; row < h; row++) {
+					int16_t shift = y0 + row * 8 - top;
+					if (shift <= -8 || shift >= 8) continue;
+					for (uint8_t col = 0; col < w && x + col < width; col++) {
+						uint8_t bits = pgm_read_byte(&(f->bitmap[offset + row * w + col]));
+						bits = shift >= 0 ? bits << shift : bits >> -shift;
+						if (bits) dl_apply(&band[x + col], bits, mode);
+					}
+				}
+				x += w;
+			}
+			break;
+		}
+	}
+}
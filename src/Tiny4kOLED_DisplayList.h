@@ -0,0 +1,77 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+#ifndef TINY4KOLED_DISPLAYLIST_H
+#define TINY4KOLED_DISPLAYLIST_H
+
+#include "Tiny4kOLED.h"
+
+// ----------------------------------------------------------------------------
+
+// The SSD1306's GDDRAM cannot be read back over I2C, and an ATtiny85 has no
+// RAM for a framebuffer. Instead, primitives are recorded in a display list,
+// and rendered one page (8 pixel rows) at a time into a single band buffer,
+// which is sent to the display in one data transaction per page.
+
+// Draw modes
+#define DISPLAYLIST_SET		0x00	// turn pixels on
+#define DISPLAYLIST_CLEAR	0x40	// turn pixels off
+#define DISPLAYLIST_INVERT	0x80	// toggle pixels
+
+typedef struct {
+	uint8_t type;         // primitive type, OR'ed with the draw mode
+	uint8_t x0, y0;       // start point, top left corner, or centre (pixels)
+	uint8_t x1, y1;       // end point, bottom right corner, or radius (pixels)
+	const void *text;     // string for text items, in RAM or PROGMEM
+	const DCfont *font;   // font for text items
+} DisplayListItem;
+
+class DisplayList {
+
+	public:
+		// items is caller supplied storage for up to capacity primitives
+		DisplayList(DisplayListItem *items, uint8_t capacity);
+
+		void clear(void);
+		uint8_t count(void) { return itemCount; }
+
+		void setDrawMode(uint8_t mode);
+		void setFont(const DCfont *font);
+
+		// each of these returns false if the display list is full
+		bool pixel(uint8_t x, uint8_t y);
+		bool hline(uint8_t x0, uint8_t y, uint8_t x1);
+		bool vline(uint8_t x, uint8_t y0, uint8_t y1);
+		bool line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+		bool rect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+		bool fillRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+		bool circle(uint8_t x, uint8_t y, uint8_t r);
+		bool fillCircle(uint8_t x, uint8_t y, uint8_t r);
+		// y is in pixels, and need not be a multiple of 8. The string must
+		// still exist when render() is called.
+		bool text(uint8_t x, uint8_t y, const char *s);
+		bool text(uint8_t x, uint8_t y, const __FlashStringHelper *s);
+
+		// render every page of the current frame of the device
+		void render(SSD1306Device &device);
+		// render into a RAM frame laid out like bitmap(), e.g. a FrameFlusher frame
+		void render(uint8_t *frame, uint8_t width, uint8_t pages);
+
+	private:
+		bool add(uint8_t type, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const void *text);
+		void renderItem(const DisplayListItem *item, uint8_t *band, uint8_t width, uint8_t top);
+
+		DisplayListItem *items;
+		uint8_t capacity;
+		uint8_t itemCount = 0;
+		uint8_t drawMode = DISPLAYLIST_SET;
+		const DCfont *font = 0;
+};
+
+// ----------------------------------------------------------------------------
+
+#endif
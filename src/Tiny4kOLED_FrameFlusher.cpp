@@ -0,0 +1,81 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+
+// ----------------------------------------------------------------------------
+
+#include "Tiny4kOLED_FrameFlusher.h"
+
+#if defined( ARDUINO_ARCH_ESP32 )
+
+FrameFlusher::FrameFlusher(SSD1306Device &device, uint8_t core) :
+	device(device), core(core) {
+}
+
+bool FrameFlusher::begin(void) {
+	if (handle)
+		return true;
+	size = device.oledWidth() * device.numberOfPages();
+	frames[0] = (uint8_t *)calloc(2, size);
+	if (!frames[0])
+		return false;
+	frames[1] = frames[0] + size;
+	done = xSemaphoreCreateBinary();
+	if (!done) {
+		free(frames[0]);
+		return false;
+	}
+	xSemaphoreGive(done);
+	if (xTaskCreatePinnedToCore(task, "Tiny4kOLED", 2048, this, 1, &handle, core) != pdPASS) {
+		vSemaphoreDelete(done);
+		free(frames[0]);
+		handle = 0;
+		return false;
+	}
+	return true;
+}
+
+void FrameFlusher::flush(bool keepContents) {
+	xSemaphoreTake(done, portMAX_DELAY);
+	uint8_t front = back;
+	back ^= 1;
+	if (keepContents) {
+		memcpy(frames[back], frames[front], size);
+	}
+	xTaskNotifyGive(handle);
+}
+
+void FrameFlusher::wait(void) {
+	xSemaphoreTake(done, portMAX_DELAY);
+	xSemaphoreGive(done);
+}
+
+bool FrameFlusher::busy(void) {
+	return uxSemaphoreGetCount(done) == 0;
+}
+
+void FrameFlusher::task(void *parameter) {
+	FrameFlusher *flusher = (FrameFlusher *)parameter;
+	for (;;) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		// the sketch is now rendering into frames[back]
+		flusher->send(flusher->frames[flusher->back ^ 1]);
+		xSemaphoreGive(flusher->done);
+	}
+}
+
+void FrameFlusher::send(uint8_t *data) {
+	device.setWindow(0, 0, device.oledWidth() - 1, device.numberOfPages() - 1);
+	device.startData();
+	for (uint16_t i = 0; i < size; i++) {
+		device.sendData(data[i]);
+	}
+	device.endData();
+	device.endWindow();
+}
+
+#endif
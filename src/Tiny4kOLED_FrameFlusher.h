@@ -0,0 +1,61 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+#ifndef TINY4KOLED_FRAMEFLUSHER_H
+#define TINY4KOLED_FRAMEFLUSHER_H
+
+#include "Tiny4kOLED.h"
+
+#if defined( ARDUINO_ARCH_ESP32 )
+
+// ----------------------------------------------------------------------------
+
+// Sends whole frames to a panel from its own FreeRTOS task, so that panels
+// on separate I2C buses (e.g. Wire and Wire1) are updated at the same time,
+// and the sketch can render the next frame while the current one is sent.
+//
+// Frames are in the same layout as bitmap(): oledWidth() bytes per page.
+// While a frame is being sent, the sketch must not draw directly on the
+// device, or on any other device sharing its bus.
+
+class FrameFlusher {
+
+	public:
+		// core is the ESP32 core (0 or 1) to run the sending task on
+		FrameFlusher(SSD1306Device &device, uint8_t core = 1);
+
+		// allocates two frames and starts the task; false if out of memory
+		bool begin(void);
+		// the frame to render into
+		uint8_t *frame(void) { return frames[back]; }
+		uint16_t frameSize(void) { return size; }
+		// send the rendered frame. This waits for the previous frame to finish,
+		// then copies the frame being sent into the next one to render into,
+		// unless keepContents is false.
+		void flush(bool keepContents = true);
+		// wait for the frame being sent to finish
+		void wait(void);
+		bool busy(void);
+
+	private:
+		static void task(void *parameter);
+		void send(uint8_t *data);
+
+		SSD1306Device &device;
+		uint8_t core;
+		uint8_t *frames[2] = { 0, 0 };
+		uint8_t back = 0;
+		uint16_t size = 0;
+		TaskHandle_t handle = 0;
+		SemaphoreHandle_t done = 0;
+};
+
+// ----------------------------------------------------------------------------
+
+#endif
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+
+// ----------------------------------------------------------------------------
+
+#include "Tiny4kOLED_Grayscale.h"
+
+Grayscale::Grayscale(SSD1306Device &device, unsigned long periodMicros) :
+	device(device), period(periodMicros) {
+}
+
+void Grayscale::bitmap(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const uint8_t msbPlane[], const uint8_t lsbPlane[]) {
+	uint8_t frame = device.currentRenderFrame();
+	if (frame != 0) device.switchRenderFrame();
+	device.bitmap(x0, y0, x1, y1, msbPlane);
+	device.switchRenderFrame();
+	device.bitmap(x0, y0, x1, y1, lsbPlane);
+	if (device.currentRenderFrame() != frame) device.switchRenderFrame();
+}
+
+void Grayscale::start(void) {
+	if (!device.offScreenRender())
+		return;
+	running = true;
+	show(0);
+	lastFlip = micros();
+}
+
+void Grayscale::stop(void) {
+	if (!running)
+		return;
+	running = false;
+	// flips bypass the device, so put back the frame and contrast it thinks are shown
+	device.startCommand();
+	device.sendCommand(0x81);
+	device.sendCommand(device.currentContrast());
+	device.sendCommand(0x40 | (device.currentDisplayFrame() << 5));
+	device.endCommand();
+}
+
+void Grayscale::update(void) {
+	if (!running)
+		return;
+	unsigned long dwell = (shown == 0 && !modulate) ? period * 2 : period;
+	unsigned long now = micros();
+	if (now - lastFlip < dwell)
+		return;
+	// stay in step, unless so late that catching up would just flicker
+	lastFlip = (now - lastFlip < dwell + period) ? lastFlip + dwell : now;
+	show(shown ^ 1);
+}
+
+// one command transaction: the start line of the frame, and its contrast when modulating
+void Grayscale::show(uint8_t frame) {
+	shown = frame;
+	device.startCommand();
+	if (modulate) {
+		uint8_t contrast = device.currentContrast();
+		device.sendCommand(0x81);
+		device.sendCommand(frame ? contrast >> 1 : contrast);
+	}
+	device.sendCommand(0x40 | (frame << 5));
+	device.endCommand();
+}
@@ -0,0 +1,52 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+#ifndef TINY4KOLED_GRAYSCALE_H
+#define TINY4KOLED_GRAYSCALE_H
+
+#include "Tiny4kOLED.h"
+
+// ----------------------------------------------------------------------------
+
+// Four shades on a 128x32 panel, by holding the most significant bit plane
+// of an image in frame 0 and the least significant in frame 1, and flipping
+// between them with one command. Frame 0 is shown twice as long as frame 1,
+// or, with contrast modulation, for as long but twice as bright.
+//
+// Use tools/grayscale.py to split an image into the two bit planes.
+
+class Grayscale {
+
+	public:
+		// periodMicros is how long frame 1 is shown for. Much above 10ms flickers.
+		Grayscale(SSD1306Device &device, unsigned long periodMicros = 5000);
+
+		// show both frames for the same time, frame 1 at half the device's contrast
+		void setContrastModulation(bool enable) { modulate = enable; }
+
+		// write the bit planes of an image, in bitmap() layout, into the two frames
+		void bitmap(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const uint8_t msbPlane[], const uint8_t lsbPlane[]);
+
+		void start(void);
+		// shows the device's display frame again, at its contrast
+		void stop(void);
+		// call often, e.g. from loop(); flips frames when it is time to
+		void update(void);
+
+	private:
+		void show(uint8_t frame);
+
+		SSD1306Device &device;
+		unsigned long period, lastFlip = 0;
+		uint8_t shown = 0;
+		bool modulate = false;
+		bool running = false;
+};
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+
+// ----------------------------------------------------------------------------
+
+#include "Tiny4kOLED_PowerManager.h"
+
+PowerManager::PowerManager(SSD1306Device &device, unsigned long dimAfter, unsigned long sleepAfter, uint8_t dimContrast) :
+	device(device), dimAfter(dimAfter), sleepAfter(sleepAfter), dimContrast(dimContrast) {
+	device.setActivityListener(this);
+}
+
+void PowerManager::activity(void) {
+	lastActivity = millis();
+	if (powerState != POWER_AWAKE) {
+		wake();
+	}
+}
+
+void PowerManager::update(void) {
+	unsigned long idle = millis() - lastActivity;
+
+	if (powerState == POWER_AWAKE && dimAfter && idle >= dimAfter) {
+		// sent directly, so the device still remembers the contrast to restore
+		device.startCommand();
+		device.sendCommand(0x81);
+		device.sendCommand(dimContrast);
+		device.endCommand();
+		powerState = POWER_DIMMED;
+	}
+
+	if (powerState != POWER_ASLEEP && sleepAfter && idle >= sleepAfter) {
+		device.startCommand();
+		device.sendCommand(0xAE);
+		device.sendCommand(0x8D);
+		device.sendCommand(0x10);
+		device.endCommand();
+		powerState = POWER_ASLEEP;
+	}
+}
+
+void PowerManager::wake(void) {
+	if (powerState == POWER_AWAKE)
+		return;
+
+	device.startCommand();
+	if (powerState == POWER_ASLEEP) {
+		// the charge pump has to be running before the display is turned on
+		device.sendCommand(0x8D);
+		device.sendCommand(device.isChargePumpEnabled() ? 0x14 : 0x10);
+	}
+	device.sendCommand(0x81);
+	device.sendCommand(device.currentContrast());
+	if (powerState == POWER_ASLEEP && device.isDisplayOn()) {
+		device.sendCommand(0xAF);
+	}
+	device.endCommand();
+	powerState = POWER_AWAKE;
+	lastActivity = millis();
+}
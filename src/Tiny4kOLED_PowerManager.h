@@ -0,0 +1,46 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+#ifndef TINY4KOLED_POWERMANAGER_H
+#define TINY4KOLED_POWERMANAGER_H
+
+#include "Tiny4kOLED.h"
+
+// ----------------------------------------------------------------------------
+
+// Dims the display after a period without drawing, then turns it and the
+// charge pump off. The next draw call wakes it, restoring the contrast,
+// charge pump and display on/off state in a single command transaction.
+
+#define POWER_AWAKE		0
+#define POWER_DIMMED	1
+#define POWER_ASLEEP	2
+
+class PowerManager: public SSD1306ActivityListener {
+
+	public:
+		// times are in milliseconds since the last draw call, 0 disables that step
+		PowerManager(SSD1306Device &device, unsigned long dimAfter, unsigned long sleepAfter, uint8_t dimContrast = 0x00);
+
+		// call regularly, e.g. from loop()
+		void update(void);
+		void wake(void);
+		uint8_t state(void) { return powerState; }
+
+		virtual void activity(void);
+
+	private:
+		SSD1306Device &device;
+		unsigned long dimAfter, sleepAfter;
+		unsigned long lastActivity = 0;
+		uint8_t dimContrast;
+		uint8_t powerState = POWER_AWAKE;
+};
+
+// ----------------------------------------------------------------------------
+
+#endif
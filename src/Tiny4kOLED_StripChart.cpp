@@ -0,0 +1,101 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+
+// ----------------------------------------------------------------------------
+
+#include "Tiny4kOLED_StripChart.h"
+
+StripChart::StripChart(SSD1306Device &device, uint8_t startPage, uint8_t endPage, uint8_t interval, unsigned long stepMicros, uint8_t *history) :
+	device(device), startPage(startPage), endPage(endPage), interval(interval), stepMicros(stepMicros), history(history) {
+}
+
+void StripChart::begin(void) {
+	uint8_t page = device.firstRenderPage();
+	if (scrolling) {
+		device.deactivateScroll();
+	}
+	steps = 0;
+	memset(history, 0, device.oledWidth());
+	redraw();
+	// the scroll can only be set up while it is deactivated
+	device.scrollLeft(page + startPage, interval, page + endPage);
+	device.activateScroll();
+	scrolling = true;
+	lastStep = micros();
+}
+
+void StripChart::end(void) {
+	if (!scrolling)
+		return;
+	device.deactivateScroll();
+	scrolling = false;
+	// GDDRAM has to be rewritten once the scroll is deactivated
+	redraw();
+}
+
+void StripChart::update(void) {
+	if (!scrolling)
+		return;
+	uint8_t width = device.oledWidth();
+	uint8_t missed = 0;
+	while (micros() - lastStep >= stepMicros) {
+		lastStep += stepMicros;
+		steps++;
+		history[steps % width] = sample;
+		// after falling a whole screen behind, every column has been written
+		if (missed < width) {
+			writeColumns(width - 1, 1);
+			missed++;
+		}
+	}
+}
+
+void StripChart::redraw(void) {
+	uint8_t width = device.oledWidth();
+	// split where the plot wraps from GDDRAM column 127 back to 0
+	uint8_t first = (steps + device.oledXoffset()) & 0x7F;
+	uint8_t count = 128 - first;
+	if (count >= width) {
+		writeColumns(0, width);
+	}
+	else {
+		writeColumns(0, count);
+		writeColumns(count, width - count);
+	}
+}
+
+uint8_t StripChart::columnBits(uint8_t column, uint8_t page) {
+	uint8_t width = device.oledWidth();
+	// history[steps % width] is the newest sample, shown in the rightmost column
+	uint8_t value = history[(uint8_t)(steps - (width - 1 - column)) % width];
+	uint8_t height = (endPage - startPage + 1) * 8;
+	if (value >= height) value = height - 1;
+	uint8_t row = height - 1 - value;
+	uint8_t top = page * 8;
+	if (row >= top && row < top + 8) {
+		return style == STRIPCHART_BARS ? 0xFF << (row - top) : 1 << (row - top);
+	}
+	return (style == STRIPCHART_BARS && row < top) ? 0xFF : 0x00;
+}
+
+void StripChart::writeColumns(uint8_t column, uint8_t count) {
+	uint8_t pages = endPage - startPage + 1;
+	// screen column c shows GDDRAM column c + steps; setWindow() adds
+	// oledXoffset(), and wraps at 128
+	uint8_t x = column + steps;
+	// a window, even for one page, leaves the device's cursor where it was
+	device.setWindow(x, startPage, x + count - 1, endPage);
+	device.startData();
+	for (uint8_t page = 0; page < pages; page++) {
+		for (uint8_t i = 0; i < count; i++) {
+			device.sendData(columnBits(column + i, page));
+		}
+	}
+	device.endData();
+	device.endWindow();
+}
@@ -0,0 +1,66 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+#ifndef TINY4KOLED_STRIPCHART_H
+#define TINY4KOLED_STRIPCHART_H
+
+#include "Tiny4kOLED.h"
+
+// ----------------------------------------------------------------------------
+
+// A rolling time series plot across the full width of a band of pages.
+// The SSD1306's continuous horizontal scroll moves the plot left, and the
+// chart only writes the one column that scrolls into view at each step.
+//
+// While scrolling, screen column c shows GDDRAM column c + steps, so the
+// chart counts the steps it has taken to know where each sample lives.
+// The controller can't be asked how far it has scrolled, so the chart steps
+// on a timer that must match the scroll rate: stepMicros is the scroll
+// interval (in frames) multiplied by the frame period, which depends on
+// setDisplayClock() and the multiplex ratio. Calibrate it by watching for
+// drift, and call begin() again to resynchronise.
+
+#define STRIPCHART_POINTS	0
+#define STRIPCHART_BARS		1
+
+class StripChart {
+
+	public:
+		// history is caller supplied storage for oledWidth() samples.
+		// interval is the SSD1306 scroll interval setting, 0 to 7.
+		StripChart(SSD1306Device &device, uint8_t startPage, uint8_t endPage, uint8_t interval, unsigned long stepMicros, uint8_t *history);
+
+		void setStyle(uint8_t style) { this->style = style; }
+
+		// clear the plot and start scrolling
+		void begin(void);
+		// stop scrolling, and rewrite the plot where it now appears
+		void end(void);
+		// value is in pixels from the bottom of the plot; it is shown from the next step on
+		void addSample(uint8_t value) { sample = value; }
+		// call often, e.g. from loop(); writes any columns that have scrolled into view
+		void update(void);
+		// rewrite every column of the plot
+		void redraw(void);
+
+	private:
+		uint8_t columnBits(uint8_t column, uint8_t page);
+		void writeColumns(uint8_t column, uint8_t count);
+
+		SSD1306Device &device;
+		uint8_t startPage, endPage, interval;
+		unsigned long stepMicros, lastStep = 0;
+		uint8_t *history;
+		uint8_t steps = 0;      // scroll steps taken, modulo 256 (GDDRAM is 128 columns)
+		uint8_t sample = 0;
+		uint8_t style = STRIPCHART_POINTS;
+		bool scrolling = false;
+};
+
+// ----------------------------------------------------------------------------
+
+#endif
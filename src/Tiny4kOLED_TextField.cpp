@@ -0,0 +1,87 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+
+// ----------------------------------------------------------------------------
+
+#include "Tiny4kOLED_TextField.h"
+
+TextField::TextField(SSD1306Device &device, uint8_t x, uint8_t y, uint8_t width, const DCfont *font, char *contents) :
+	device(device), x(x), y(y), width(width), font(font), contents(contents) {
+}
+
+void TextField::set(const char *text) {
+	set(text, false);
+}
+
+void TextField::set(const __FlashStringHelper *text) {
+	set((const char *)text, true);
+}
+
+void TextField::set(const char *text, bool progmem) {
+	bool ended = false, sent = false;
+	uint8_t runStart = 0xFF;
+	// single page runs move the device's cursor, so put it back afterwards
+	uint8_t cursorX = device.cursorX(), cursorY = device.cursorY();
+	for (uint8_t i = 0; i <= width; i++) {
+		bool changed = false;
+		if (i < width) {
+			char c = ' ';
+			if (!ended) {
+				c = progmem ? pgm_read_byte(&text[i]) : text[i];
+				if (c == 0) {
+					ended = true;
+					c = ' ';
+				}
+			}
+			changed = !valid || contents[i] != c;
+			contents[i] = c;
+		}
+		if (changed) {
+			if (runStart == 0xFF) runStart = i;
+		}
+		else if (runStart != 0xFF) {
+			sendRun(runStart, i);
+			sent = true;
+			runStart = 0xFF;
+		}
+	}
+	if (sent) {
+		if (font->height > 1)
+			device.endWindow();
+		else
+			device.setCursor(cursorX, cursorY);
+	}
+	valid = true;
+}
+
+void TextField::sendRun(uint8_t start, uint8_t end) {
+	uint8_t w = font->width, h = font->height;
+	uint8_t left = x + start * w;
+	// a run of multi-page glyphs needs a window to keep the pages together
+	if (h > 1) {
+		device.setWindow(left, y, left + (end - start) * w - 1, y + h - 1);
+	}
+	else {
+		device.setCursor(left, y);
+	}
+	device.startData();
+	for (uint8_t page = 0; page < h; page++) {
+		for (uint8_t i = start; i < end; i++) {
+			uint8_t c = contents[i];
+			if (c < font->first || c > font->last) {
+				for (uint8_t col = 0; col < w; col++) device.sendData(0);
+				continue;
+			}
+			uint16_t offset = ((uint16_t)DCfontGlyph(font, c) * h + page) * w;
+			for (uint8_t col = 0; col < w; col++) {
+				device.sendData(pgm_read_byte(&(font->bitmap[offset + col])));
+			}
+		}
+	}
+	device.endData();
+}
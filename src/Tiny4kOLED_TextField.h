@@ -0,0 +1,44 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+#ifndef TINY4KOLED_TEXTFIELD_H
+#define TINY4KOLED_TEXTFIELD_H
+
+#include "Tiny4kOLED.h"
+
+// ----------------------------------------------------------------------------
+
+// A fixed width text field that remembers what it last showed, so that
+// set() only sends the glyphs that changed. Adjacent changed characters are
+// sent together as a single data transaction.
+
+class TextField {
+
+	public:
+		// contents is caller supplied storage for width characters
+		TextField(SSD1306Device &device, uint8_t x, uint8_t y, uint8_t width, const DCfont *font, char *contents);
+
+		// show text, padded with spaces to the width of the field
+		void set(const char *text);
+		void set(const __FlashStringHelper *text);
+		// forget the last contents, so the next set() redraws everything (e.g. after clear())
+		void invalidate(void) { valid = false; }
+
+	private:
+		void set(const char *text, bool progmem);
+		void sendRun(uint8_t start, uint8_t end);
+
+		SSD1306Device &device;
+		uint8_t x, y, width;
+		const DCfont *font;
+		char *contents;
+		bool valid = false;
+};
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+
+// ----------------------------------------------------------------------------
+
+#include "Tiny4kOLED_TextLayout.h"
+
+TextLayout::TextLayout(const DCfont *font, uint8_t x, uint8_t y, uint8_t width, uint8_t pages) :
+	font(font), boxX(x), boxY(y), boxWidth(width), boxPages(pages) {
+}
+
+uint16_t TextLayout::textWidth(const DCfont *font, const char *s) {
+	return strlen(s) * font->width;
+}
+
+uint16_t TextLayout::textWidth(const DCfont *font, const __FlashStringHelper *s) {
+	return strlen_P((const char *)s) * font->width;
+}
+
+bool TextLayout::layout(const char *s) {
+	return layoutText(s, false);
+}
+
+bool TextLayout::layout(const __FlashStringHelper *s) {
+	return layoutText((const char *)s, true);
+}
+
+uint8_t TextLayout::charAt(uint16_t i) {
+	return progmem ? pgm_read_byte(&text[i]) : text[i];
+}
+
+bool TextLayout::layoutText(const char *s, bool progmem) {
+	text = s;
+	this->progmem = progmem;
+	lines = 0;
+	clipped = false;
+
+	uint8_t w = font->width;
+	uint8_t columns = boxWidth / w;
+	uint8_t maxLines = boxPages / font->height;
+	if (maxLines > TEXTLAYOUT_MAX_LINES) maxLines = TEXTLAYOUT_MAX_LINES;
+
+	uint16_t pos = 0;
+	uint8_t c = charAt(pos);
+	bool ranOutOfLines = false;
+	while (c) {
+		if (lines == maxLines || columns == 0) {
+			clipped = true;
+			ranOutOfLines = true;
+			break;
+		}
+		// find where this line ends, and where the next one starts
+		uint16_t end = pos, next;
+		uint16_t space = pos;
+		while ((c = charAt(end)) && c != '\n' && (!wrap || end - pos < columns)) {
+			if (c == ' ') space = end;
+			end++;
+		}
+		if (c == 0) {
+			next = end;
+		}
+		else if (c == '\n') {
+			next = end + 1;
+		}
+		else {
+			// wrapping: at this space, the last one on the line, or mid-word
+			if (c != ' ' && space > pos) end = space;
+			next = end;
+			while (charAt(next) == ' ') next++;
+		}
+
+		uint16_t length = end - pos;
+		while (length && charAt(pos + length - 1) == ' ') length--;
+		TextLayoutLine *l = &lineInfo[lines++];
+		l->start = pos;
+		l->ellipsis = false;
+		if (length > columns) {
+			clipped = true;
+			length = columns;
+			l->ellipsis = ellipsis && columns >= 3;
+		}
+		l->length = length;
+		pos = next;
+		c = charAt(pos);
+	}
+
+	// mark text that ran out of lines on the last one
+	if (ranOutOfLines && lines && ellipsis && columns >= 3) {
+		TextLayoutLine *l = &lineInfo[lines - 1];
+		if (!l->ellipsis) {
+			l->length = l->length + 3 > columns ? columns : l->length + 3;
+			l->ellipsis = true;
+		}
+	}
+
+	for (uint8_t i = 0; i < lines; i++) {
+		uint8_t space = boxWidth - lineInfo[i].length * w;
+		lineInfo[i].x = alignment == TEXTLAYOUT_CENTER ? space >> 1 : alignment == TEXTLAYOUT_RIGHT ? space : 0;
+	}
+	return !clipped;
+}
+
+uint8_t TextLayout::width(void) {
+	uint8_t widest = 0;
+	for (uint8_t i = 0; i < lines; i++) {
+		if (lineInfo[i].length > widest) widest = lineInfo[i].length;
+	}
+	return widest * font->width;
+}
+
+uint8_t TextLayout::columnByte(const TextLayoutLine *l, uint8_t column, uint8_t row) {
+	if (column < l->x)
+		return 0;
+	uint8_t w = font->width;
+	uint8_t cx = column - l->x;
+	uint8_t i = cx / w;
+	if (i >= l->length)
+		return 0;
+	uint8_t c = (l->ellipsis && i + 3 >= l->length) ? '.' : charAt(l->start + i);
+	if (c < font->first || c > font->last)
+		return 0;
+	uint16_t offset = (uint16_t)DCfontGlyph(font, c) * w * font->height;
+	return pgm_read_byte(&(font->bitmap[offset + row * w + cx - i * w]));
+}
+
+void TextLayout::render(SSD1306Device &device) {
+	uint8_t h = font->height;
+	device.setWindow(boxX, boxY, boxX + boxWidth - 1, boxY + boxPages - 1);
+	device.startData();
+	for (uint8_t page = 0; page < boxPages; page++) {
+		uint8_t i = page / h;
+		for (uint8_t column = 0; column < boxWidth; column++) {
+			device.sendData(i < lines ? columnByte(&lineInfo[i], column, page - i * h) : 0x00);
+		}
+	}
+	device.endData();
+	device.endWindow();
+}
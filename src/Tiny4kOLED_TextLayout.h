@@ -0,0 +1,86 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+#ifndef TINY4KOLED_TEXTLAYOUT_H
+#define TINY4KOLED_TEXTLAYOUT_H
+
+#include "Tiny4kOLED.h"
+
+// ----------------------------------------------------------------------------
+
+// Lays out text in a box without sending anything to the display: measuring,
+// word wrapping at spaces and '\n', aligning each line, and truncating with an
+// ellipsis when the text doesn't fit. render() then draws the whole box,
+// text and blank space alike, in one data transaction, so text that moved
+// doesn't need clearing first.
+
+// Alignment
+#define TEXTLAYOUT_LEFT		0
+#define TEXTLAYOUT_CENTER	1
+#define TEXTLAYOUT_RIGHT	2
+
+// one per page of the tallest box, the most lines a 1 page font can lay out
+#define TEXTLAYOUT_MAX_LINES	8
+
+typedef struct {
+	uint16_t start;       // offset into the string
+	uint8_t length;       // characters, including the ellipsis
+	uint8_t x;            // pixels from the left of the box
+	bool ellipsis;        // the last three characters are replaced by "..."
+} TextLayoutLine;
+
+class TextLayout {
+
+	public:
+		// x and width are in pixels, y and pages are in pages
+		TextLayout(const DCfont *font, uint8_t x, uint8_t y, uint8_t width, uint8_t pages);
+
+		// measurements in pixels and pages, for strings without line breaks
+		static uint16_t textWidth(const DCfont *font, const char *s);
+		static uint16_t textWidth(const DCfont *font, const __FlashStringHelper *s);
+		static uint8_t lineHeight(const DCfont *font) { return font->height; }
+
+		void setAlignment(uint8_t alignment) { this->alignment = alignment; }
+		// without wrapping, each '\n' separated line is truncated to the box width
+		void setWrap(bool wrap) { this->wrap = wrap; }
+		void setEllipsis(bool ellipsis) { this->ellipsis = ellipsis; }
+
+		// the dry run. The string must still exist when render() is called.
+		// Returns false if some of the text didn't fit.
+		bool layout(const char *s);
+		bool layout(const __FlashStringHelper *s);
+
+		uint8_t lineCount(void) { return lines; }
+		const TextLayoutLine *line(uint8_t i) { return &lineInfo[i]; }
+		// the laid out text's extent: widest line in pixels, and pages used
+		uint8_t width(void);
+		uint8_t height(void) { return lines * font->height; }
+		bool truncated(void) { return clipped; }
+
+		void render(SSD1306Device &device);
+
+	private:
+		bool layoutText(const char *s, bool progmem);
+		uint8_t charAt(uint16_t i);
+		uint8_t columnByte(const TextLayoutLine *l, uint8_t column, uint8_t row);
+
+		const DCfont *font;
+		uint8_t boxX, boxY, boxWidth, boxPages;
+		uint8_t alignment = TEXTLAYOUT_LEFT;
+		bool wrap = true;
+		bool ellipsis = true;
+
+		const char *text = 0;
+		bool progmem = false;
+		bool clipped = false;
+		uint8_t lines = 0;
+		TextLayoutLine lineInfo[TEXTLAYOUT_MAX_LINES];
+};
+
+// ----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+#ifndef TINY4KOLED_TRANSPOSE_H
+#define TINY4KOLED_TRANSPOSE_H
+
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------
+
+// 8x8 bit matrix transpose, from eight row-major bytes (leftmost pixel in the
+// most significant bit) to eight SSD1306 columns (top pixel in the least
+// significant bit). The word-wide versions are the delta swaps from Hacker's
+// Delight 7-3, with the rows loaded bottom first so the result needs no bit
+// reversal.
+
+// one bit at a time, using only byte shifts, which suits 8 bit processors
+static inline void tiny4koled_transpose8x8_bytes(const uint8_t rows[8], uint8_t columns[8]) {
+	for (uint8_t c = 0; c < 8; c++) columns[c] = 0;
+	for (uint8_t r = 8; r--; ) {
+		uint8_t row = rows[r];
+		for (uint8_t c = 0; c < 8; c++) {
+			columns[c] = (columns[c] << 1) | (row >> 7);
+			row <<= 1;
+		}
+	}
+}
+
+// two 32 bit halves, for 32 bit processors
+static inline void tiny4koled_transpose8x8_32(const uint8_t rows[8], uint8_t columns[8]) {
+	uint32_t x = ((uint32_t)rows[7] << 24) | ((uint32_t)rows[6] << 16) | ((uint32_t)rows[5] << 8) | rows[4];
+	uint32_t y = ((uint32_t)rows[3] << 24) | ((uint32_t)rows[2] << 16) | ((uint32_t)rows[1] << 8) | rows[0];
+	uint32_t t;
+	t = (x ^ (x >> 7)) & 0x00AA00AA;  x ^= t ^ (t << 7);
+	t = (y ^ (y >> 7)) & 0x00AA00AA;  y ^= t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC; x ^= t ^ (t << 14);
+	t = (y ^ (y >> 14)) & 0x0000CCCC; y ^= t ^ (t << 14);
+	t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+	y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+	x = t;
+	columns[0] = x >> 24; columns[1] = x >> 16; columns[2] = x >> 8; columns[3] = x;
+	columns[4] = y >> 24; columns[5] = y >> 16; columns[6] = y >> 8; columns[7] = y;
+}
+
+// one 64 bit word, for 64 bit processors
+static inline void tiny4koled_transpose8x8_64(const uint8_t rows[8], uint8_t columns[8]) {
+	uint64_t x = 0, t;
+	for (uint8_t r = 8; r--; ) x = (x << 8) | rows[r];
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;  x ^= t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL; x ^= t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL; x ^= t ^ (t << 28);
+	for (uint8_t c = 8; c--; ) {
+		columns[c] = x;
+		x >>= 8;
+	}
+}
+
+// the best fit for this processor
+static inline void tiny4koled_transpose8x8(const uint8_t rows[8], uint8_t columns[8]) {
+#if defined( __AVR__ )
+	tiny4koled_transpose8x8_bytes(rows, columns);
+#elif UINTPTR_MAX > 0xFFFFFFFF
+	tiny4koled_transpose8x8_64(rows, columns);
+#else
+	tiny4koled_transpose8x8_32(rows, columns);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+#endif
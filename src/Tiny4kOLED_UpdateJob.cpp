@@ -0,0 +1,70 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+
+// ----------------------------------------------------------------------------
+
+#include "Tiny4kOLED_UpdateJob.h"
+
+void UpdateJob::fill(uint8_t fill) {
+	source = 0;
+	fillByte = fill;
+	x0 = 0;
+	y0 = 0;
+	width = device.oledWidth();
+	position = 0;
+	left = width * device.visiblePages();
+}
+
+void UpdateJob::bitmap(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const uint8_t bitmap[]) {
+	source = bitmap;
+	this->x0 = x0;
+	this->y0 = y0;
+	width = x1 - x0;
+	position = 0;
+	left = width * (y1 - y0);
+}
+
+bool UpdateJob::update(uint16_t maxBytes) {
+	while (left && maxBytes) {
+		maxBytes -= step(maxBytes > 0xFF ? 0xFF : maxBytes);
+	}
+	return done();
+}
+
+bool UpdateJob::updateMicros(unsigned long maxMicros) {
+	unsigned long start = micros();
+	do {
+		if (!left) break;
+		step(UPDATEJOB_CHUNK);
+	}
+	while (micros() - start < maxMicros);
+	return done();
+}
+
+// one data transaction, within a single page of the job, leaving the
+// device's cursor where the sketch had it
+uint8_t UpdateJob::step(uint8_t maxBytes) {
+	uint8_t page = position / width;
+	uint8_t column = position % width;
+	uint8_t count = width - column;
+	if (count > maxBytes) count = maxBytes;
+
+	uint8_t cursorX = device.cursorX(), cursorY = device.cursorY();
+	device.setCursor(x0 + column, y0 + page);
+	device.startData();
+	for (uint8_t i = 0; i < count; i++) {
+		device.sendData(source ? pgm_read_byte(&source[position + i]) : fillByte);
+	}
+	device.endData();
+
+	device.setCursor(cursorX, cursorY);
+
+	position += count;
+	left -= count;
+	return count;
+}
@@ -0,0 +1,58 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+#ifndef TINY4KOLED_UPDATEJOB_H
+#define TINY4KOLED_UPDATEJOB_H
+
+#include "Tiny4kOLED.h"
+
+// ----------------------------------------------------------------------------
+
+// A fill() or bitmap() that is sent a little at a time, so a cooperative
+// loop() isn't held up by a full screen update. Each step is one data
+// transaction, after which the device's cursor is put back where it was, so
+// text printed between steps still lands where the sketch expects.
+//
+// Combine with switchRenderFrame() on a 128x32 panel to build the next frame
+// over many loop() iterations, then switchDisplayFrame() once it is done().
+
+// bytes per data transaction when stepping against a time budget
+#ifndef UPDATEJOB_CHUNK
+#define UPDATEJOB_CHUNK 16
+#endif
+
+class UpdateJob {
+
+	public:
+		UpdateJob(SSD1306Device &device) : device(device) {}
+
+		// start a job; any unfinished job is abandoned
+		void fill(uint8_t fill);
+		void bitmap(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const uint8_t bitmap[]);
+		void cancel(void) { left = 0; }
+
+		// send at most maxBytes; returns true once the job is done
+		bool update(uint16_t maxBytes);
+		// send chunks until maxMicros have passed, always at least one
+		bool updateMicros(unsigned long maxMicros);
+
+		uint16_t remaining(void) { return left; }
+		bool done(void) { return left == 0; }
+
+	private:
+		uint8_t step(uint8_t maxBytes);
+
+		SSD1306Device &device;
+		const uint8_t *source = 0;  // PROGMEM bitmap, or 0 to fill
+		uint8_t fillByte = 0;
+		uint8_t x0 = 0, y0 = 0, width = 0;
+		uint16_t position = 0, left = 0;
+};
+
+// ----------------------------------------------------------------------------
+
+#endif
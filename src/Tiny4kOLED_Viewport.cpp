@@ -0,0 +1,191 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+
+// ----------------------------------------------------------------------------
+
+#include "Tiny4kOLED_Viewport.h"
+
+Viewport::Viewport(SSD1306Device &device, uint8_t x, uint8_t y, uint8_t width, uint8_t pages, const DCfont *font, char *lines) :
+	device(device), x(x), y(y), width(width), pages(pages), font(font), lines(lines) {
+	columns = width / font->width;
+	rows = pages / font->height;
+	// too small for a whole character, so there's nothing to scroll
+	if (columns == 0 || rows == 0) {
+		this->lines = 0;
+	}
+	if (this->lines) {
+		memset(lines, ' ', columns * rows);
+	}
+}
+
+void Viewport::setCursor(uint8_t x, uint8_t y) {
+	oledX = x;
+	oledY = y;
+}
+
+void Viewport::setWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+	device.setWindow(x + x0, y + y0, x + x1, y + y1);
+}
+
+// stream font->height pages of glyph columns into the current window,
+// followed on each page by padding blank columns
+void Viewport::sendGlyphs(const uint8_t *s, uint8_t count, uint8_t padding) {
+	uint8_t w = font->width, h = font->height;
+	for (uint8_t page = 0; page < h; page++) {
+		const uint8_t *c = s;
+		uint8_t column = 0;
+		uint16_t offset = 0;
+		bool blank = true;
+		for (uint8_t i = 0; i < count; i++) {
+			if (column == 0) {
+				blank = *c < font->first || *c > font->last;
+				if (!blank) offset = (uint16_t)DCfontGlyph(font, *c) * w * h + page * w;
+			}
+			device.sendData(blank ? 0x00 : pgm_read_byte(&(font->bitmap[offset + column])));
+			if (++column == w) {
+				column = 0;
+				c++;
+			}
+		}
+		for (uint8_t i = 0; i < padding; i++) {
+			device.sendData(0x00);
+		}
+	}
+}
+
+void Viewport::fillArea(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t fill) {
+	setWindow(x0, y0, x1, y1);
+	device.startData();
+	for (uint16_t i = (uint16_t)(x1 - x0 + 1) * (y1 - y0 + 1); i; i--) {
+		device.sendData(fill);
+	}
+	device.endData();
+	device.endWindow();
+	windowOpen = false;
+}
+
+void Viewport::fill(uint8_t fill) {
+	fillArea(0, 0, width - 1, pages - 1, fill);
+}
+
+void Viewport::clear(void) {
+	fill(0x00);
+	if (lines) {
+		memset(lines, ' ', columns * rows);
+	}
+	oledX = 0;
+	oledY = 0;
+}
+
+void Viewport::clearToEOL(void) {
+	if (oledX >= width || oledY >= pages)
+		return;
+	uint8_t bottom = oledY + font->height - 1;
+	fillArea(oledX, oledY, width - 1, bottom < pages ? bottom : pages - 1, 0x00);
+	uint8_t row = oledY / font->height;
+	uint8_t column = (oledX + font->width - 1) / font->width;
+	if (lines && row < rows && column < columns) {
+		memset(lines + row * columns + column, ' ', columns - column);
+	}
+}
+
+void Viewport::newLine(void) {
+	uint8_t h = font->height;
+	oledX = 0;
+	if (oledY + h * 2 <= pages) {
+		oledY += h;
+	}
+	else if (lines) {
+		scroll();
+	}
+	else {
+		// no text to scroll with, so start again on the top line
+		oledY = 0;
+		clearToEOL();
+	}
+}
+
+// move the text up a line, and redraw the whole viewport in one transaction
+void Viewport::scroll(void) {
+	uint8_t h = font->height;
+	memmove(lines, lines + columns, columns * (rows - 1));
+	memset(lines + columns * (rows - 1), ' ', columns);
+	oledY = (rows - 1) * h;
+
+	uint8_t padding = width - columns * font->width;
+	setWindow(0, 0, width - 1, rows * h - 1);
+	device.startData();
+	for (uint8_t row = 0; row < rows; row++) {
+		sendGlyphs((const uint8_t *)lines + row * columns, columns * font->width, padding);
+	}
+	device.endData();
+	device.endWindow();
+	windowOpen = false;
+}
+
+size_t Viewport::write(uint8_t c) {
+	return write(&c, 1);
+}
+
+size_t Viewport::write(const uint8_t *buffer, size_t size) {
+	uint8_t w = font->width, h = font->height;
+	// narrower than a character, so clip instead of wrapping forever
+	bool wrapping = wrap && columns;
+	size_t i = 0;
+	while (i < size) {
+		uint8_t c = buffer[i];
+		if (c == '\r' || c == '\n' || c == '\t') {
+			if (c == '\n') newLine();
+			if (c == '\t') clearToEOL();
+			i++;
+			continue;
+		}
+		if (oledX + w > width && wrapping) {
+			newLine();
+			continue;
+		}
+		if (oledX >= width || oledY + h > pages) {
+			// clipped
+			i++;
+			continue;
+		}
+
+		// the run of characters that fits on this line
+		size_t end = i;
+		uint16_t right = oledX;
+		while (end < size && right < width && (!wrapping || right + w <= width)) {
+			c = buffer[end];
+			if (c == '\r' || c == '\n' || c == '\t') break;
+			end++;
+			right += w;
+		}
+		uint8_t count = (right < width ? right : width) - oledX;
+
+		setWindow(oledX, oledY, oledX + count - 1, oledY + h - 1);
+		windowOpen = true;
+		device.startData();
+		sendGlyphs(buffer + i, count, 0);
+		device.endData();
+
+		if (lines && oledY % h == 0) {
+			uint8_t row = oledY / h;
+			uint8_t column = oledX / w;
+			for (size_t j = i; j < end && column < columns; j++) {
+				lines[row * columns + column++] = buffer[j];
+			}
+		}
+		oledX = right < width ? right : width;
+		i = end;
+	}
+	// each run sets its own window, so only the last needs ending
+	if (windowOpen) {
+		device.endWindow();
+		windowOpen = false;
+	}
+	return size;
+}
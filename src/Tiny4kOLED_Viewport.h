@@ -0,0 +1,68 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ */
+#ifndef TINY4KOLED_VIEWPORT_H
+#define TINY4KOLED_VIEWPORT_H
+
+#include "Tiny4kOLED.h"
+
+// ----------------------------------------------------------------------------
+
+// A rectangular region of the screen with its own font and cursor, e.g. a
+// header, body and status bar. Text and fills are clipped to the viewport,
+// and lines wrap and scroll within it. Output goes through a window, so a
+// print() is one data transaction per line of text, and the device's own
+// cursor is left where it was.
+//
+// print(F("...")) writes one character at a time on AVR, so each character
+// sets up its own window. Printing RAM strings avoids that.
+
+class Viewport : public Print {
+
+	public:
+		// x and width are in pixels, y and pages are in pages. lines is optional
+		// caller supplied storage for (width / font width) * (pages / font height)
+		// characters, which lets the viewport scroll by redrawing its text.
+		// Without it, or if the viewport is smaller than a character, text
+		// continues from the top line instead.
+		Viewport(SSD1306Device &device, uint8_t x, uint8_t y, uint8_t width, uint8_t pages, const DCfont *font, char *lines = 0);
+
+		// within the viewport, x in pixels and y in pages
+		void setCursor(uint8_t x, uint8_t y);
+		uint8_t cursorX(void) { return oledX; }
+		uint8_t cursorY(void) { return oledY; }
+		// without wrapping, text past the right edge is dropped
+		void setWrap(bool wrap) { this->wrap = wrap; }
+
+		void newLine(void);
+		void fill(uint8_t fill);
+		void clear(void);
+		void clearToEOL(void);
+
+		virtual size_t write(uint8_t c);
+		virtual size_t write(const uint8_t *buffer, size_t size);
+		using Print::write;
+
+	private:
+		void setWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+		void sendGlyphs(const uint8_t *s, uint8_t columns, uint8_t padding);
+		void fillArea(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t fill);
+		void scroll(void);
+
+		SSD1306Device &device;
+		uint8_t x, y, width, pages;
+		const DCfont *font;
+		char *lines;
+		uint8_t columns, rows;
+		uint8_t oledX = 0, oledY = 0;
+		bool wrap = true;
+		bool windowOpen = false;
+};
+
+// ----------------------------------------------------------------------------
+
+#endif
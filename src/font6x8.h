@@ -120,7 +120,8 @@ const DCfont TinyOLED4kfont6x8 = {
   (uint8_t *)ssd1306xled_font6x8,
   6, // character width in pixels
   1, // character height in pages (8 pixels)
-  32,126 // ASCII extents
+  32,126, // ASCII extents
+  0 // no remap table
   };
 
 // for backwards compatibility
@@ -120,7 +120,8 @@ const DCfont TinyOLED4kfont8x16 = {
   (uint8_t *)ssd1306xled_font8x16,
   8, // character width in pixels
   2, // character height in pages (8 pixels)
-  32,126 // ASCII extents
+  32,126, // ASCII extents
+  0 // no remap table
   };
 
 // for backwards compatibility
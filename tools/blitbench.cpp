@@ -0,0 +1,90 @@
+/*
+ * Tiny4kOLED blit benchmark.
+ *
+ * Times converting a row-major 1 bit per pixel 128x64 image into SSD1306
+ * page layout, per pixel as a sketch would naively do it, and with each of
+ * the 8x8 transpose kernels blit() chooses between. Every result is checked
+ * against the per pixel conversion.
+ *
+ * usage, on Linux:
+ *   g++ -O2 -I../src blitbench.cpp -o blitbench && ./blitbench
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Tiny4kOLED_Transpose.h"
+
+#define WIDTH	128
+#define HEIGHT	64
+#define STRIDE	(WIDTH / 8)
+#define PAGES	(HEIGHT / 8)
+#define FRAMES	20000
+
+typedef void (*Kernel)(const uint8_t rows[8], uint8_t columns[8]);
+
+static void convertPerPixel(const uint8_t *image, uint8_t *out) {
+	for (int page = 0; page < PAGES; page++) {
+		for (int x = 0; x < WIDTH; x++) {
+			uint8_t bits = 0;
+			for (int b = 0; b < 8; b++) {
+				if (image[(page * 8 + b) * STRIDE + (x >> 3)] & (0x80 >> (x & 7)))
+					bits |= 1 << b;
+			}
+			*out++ = bits;
+		}
+	}
+}
+
+static void convertBlocks(const uint8_t *image, uint8_t *out, Kernel kernel) {
+	uint8_t rows[8];
+	for (int page = 0; page < PAGES; page++) {
+		const uint8_t *block = image + page * 8 * STRIDE;
+		for (int b = 0; b < STRIDE; b++, block++) {
+			for (int r = 0; r < 8; r++) rows[r] = block[r * STRIDE];
+			kernel(rows, out);
+			out += 8;
+		}
+	}
+}
+
+static unsigned sink = 0;
+
+static double nanosPerFrame(void (*convert)(const uint8_t *, uint8_t *, Kernel), Kernel kernel, const uint8_t *image, uint8_t *out) {
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < FRAMES; i++) {
+		convert(image, out, kernel);
+		sink += out[i % (WIDTH * PAGES)];
+	}
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / FRAMES;
+}
+
+static void perPixel(const uint8_t *image, uint8_t *out, Kernel) {
+	convertPerPixel(image, out);
+}
+
+int main() {
+	static uint8_t image[STRIDE * HEIGHT], expected[WIDTH * PAGES], out[WIDTH * PAGES];
+	srand(1);
+	for (unsigned i = 0; i < sizeof(image); i++) image[i] = rand();
+	convertPerPixel(image, expected);
+
+	struct { const char *name; Kernel kernel; } kernels[] = {
+		{ "bytes (AVR)", tiny4koled_transpose8x8_bytes },
+		{ "32 bit (ESP)", tiny4koled_transpose8x8_32 },
+		{ "64 bit", tiny4koled_transpose8x8_64 },
+	};
+
+	double base = nanosPerFrame(perPixel, 0, image, out);
+	printf("%-14s %10.0f ns/frame\n", "per pixel", base);
+	for (auto &k : kernels) {
+		double t = nanosPerFrame(convertBlocks, k.kernel, image, out);
+		bool ok = memcmp(out, expected, sizeof(out)) == 0;
+		printf("%-14s %10.0f ns/frame  %5.1fx  %s\n", k.name, t, base / t, ok ? "ok" : "MISMATCH");
+		if (!ok) return 1;
+	}
+	return sink == 0xFFFFFFFF;
+}
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""
+Tiny4kOLED font subsetter.
+
+Writes a font header containing only the characters that a sketch actually
+prints, plus a remap table, so that write() can still find each glyph in
+constant time.
+
+Every string and character literal in the given sketch files is scanned,
+along with any characters listed with --extra (for characters that are only
+ever printed from variables, e.g. "0123456789-.").
+
+usage:
+  python3 fontsubset.py --font ../src/font6x8.h --name font6x8subset \\
+      --extra "0123456789" MySketch.ino > font6x8subset.h
+
+then in the sketch:
+  #include "font6x8subset.h"
+  oled.setFont(&font6x8subset);
+"""
+
+import argparse
+import re
+import sys
+
+ESCAPES = {'n': '\n', 't': '\t', 'r': '\r', '0': '\0', '\\': '\\',
+           '"': '"', "'": "'", 'a': '\a', 'b': '\b', 'f': '\f', 'v': '\v', '?': '?'}
+
+
+def strip_comments(text):
+    return re.sub(r'//[^\n]*|/\*.*?\*/', '', text, flags=re.S)
+
+
+def read_font(path):
+    """Returns (bitmap bytes, width, height, first, last) of the DCfont in a font header."""
+    text = strip_comments(open(path, encoding='latin-1').read())
+    array = re.search(r'uint8_t\s+(\w+)\s*\[\s*\]\s*PROGMEM\s*=\s*\{(.*?)\}', text, re.S)
+    if not array:
+        sys.exit('%s: no PROGMEM bitmap array found' % path)
+    name, body = array.groups()
+    bitmap = [int(v, 0) for v in re.findall(r'0[xX][0-9a-fA-F]+|\d+', body)]
+    font = re.search(r'DCfont\s+\w+\s*=\s*\{\s*\(\s*uint8_t\s*\*\s*\)\s*' + name +
+                     r'\s*,\s*(\d+)\s*,\s*(\d+)\s*,\s*(\d+)\s*,\s*(\d+)', text)
+    if not font:
+        sys.exit('%s: no DCfont using %s found' % (path, name))
+    width, height, first, last = (int(v) for v in font.groups())
+    return bitmap, width, height, first, last
+
+
+def literals(text):
+    """Yields the contents of every string and character literal, skipping comments."""
+    i = 0
+    while i < len(text):
+        c = text[i]
+        if text.startswith('//', i):
+            i = text.find('\n', i)
+            if i < 0:
+                return
+        elif text.startswith('/*', i):
+            i = text.find('*/', i)
+            if i < 0:
+                return
+            i += 2
+        elif c in '"\'':
+            i += 1
+            value = []
+            while i < len(text) and text[i] != c:
+                if text[i] == '\\' and i + 1 < len(text):
+                    i += 1
+                    e = text[i]
+                    if e == 'x':
+                        digits = re.match(r'[0-9a-fA-F]+', text[i + 1:])
+                        if digits:
+                            value.append(chr(int(digits.group(), 16) & 0xFF))
+                            i += len(digits.group())
+                    elif e in '01234567':
+                        digits = re.match(r'[0-7]{1,3}', text[i:]).group()
+                        value.append(chr(int(digits, 8) & 0xFF))
+                        i += len(digits) - 1
+                    else:
+                        value.append(ESCAPES.get(e, e))
+                else:
+                    value.append(text[i])
+                i += 1
+            yield ''.join(value)
+        i += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Subset a Tiny4kOLED font to the characters a sketch uses.')
+    parser.add_argument('--font', required=True, help='font header, e.g. src/font6x8.h')
+    parser.add_argument('--name', required=True, help='name of the generated DCfont')
+    parser.add_argument('--extra', default='', help='additional characters to include')
+    parser.add_argument('sources', nargs='*', help='sketch files to scan for literals')
+    args = parser.parse_args()
+
+    bitmap, width, height, first, last = read_font(args.font)
+    glyph_size = width * height
+
+    used = set(args.extra)
+    for path in args.sources:
+        for literal in literals(open(path, encoding='latin-1').read()):
+            used.update(literal)
+    codes = sorted(ord(c) for c in used if first <= ord(c) <= last)
+    if not codes:
+        sys.exit('none of the characters used are in the font')
+
+    # the first glyph is also shown for characters missing from the subset,
+    # so keep the font's first character (normally a space) as glyph 0
+    glyphs = [first] + [c for c in codes if c != first]
+    sub_first, sub_last = min(codes), max(codes)
+    remap = [glyphs.index(c) if c in glyphs else 0 for c in range(sub_first, sub_last + 1)]
+    if len(glyphs) > 256:
+        sys.exit('a subset font can have at most 256 glyphs')
+
+    out = sys.stdout
+    out.write('// Generated by tools/fontsubset.py from %s\n' % args.font)
+    out.write('// %d of %d characters, %d bytes instead of %d\n\n' % (
+        len(glyphs) - (first not in codes), last - first + 1,
+        len(glyphs) * glyph_size + len(remap), len(bitmap)))
+    out.write('const uint8_t %s_bitmap [] PROGMEM = {\n' % args.name)
+    for g, c in enumerate(glyphs):
+        data = bitmap[(c - first) * glyph_size:(c - first + 1) * glyph_size]
+        label = chr(c) if c < 127 and chr(c) not in '\\' else ' '
+        out.write('  %s, // %s %d\n' % (','.join('0x%02x' % b for b in data), label, g))
+    out.write('};\n\n')
+    out.write('const uint8_t %s_remap [] PROGMEM = {\n' % args.name)
+    for row in range(0, len(remap), 16):
+        out.write('  %s,\n' % ','.join('%d' % g for g in remap[row:row + 16]))
+    out.write('};\n\n')
+    out.write('const DCfont %s = {\n' % args.name)
+    out.write('  (uint8_t *)%s_bitmap,\n' % args.name)
+    out.write('  %d, // character width in pixels\n' % width)
+    out.write('  %d, // character height in pages (8 pixels)\n' % height)
+    out.write('  %d,%d, // ASCII extents\n' % (sub_first, sub_last))
+    out.write('  %s_remap // glyph number of each character\n' % args.name)
+    out.write('  };\n')
+
+
+if __name__ == '__main__':
+    main()
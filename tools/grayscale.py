@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+Tiny4kOLED grayscale converter.
+
+Splits an image into the two bit planes used by the Grayscale class, each
+in the page layout bitmap() expects. Pixels are quantised to four shades;
+the most significant bit plane goes in frame 0 and the least in frame 1.
+
+Binary or ASCII PGM files are read directly; other formats need Pillow.
+
+usage:
+  python3 grayscale.py --name gauge gauge.png > gauge.h
+
+then in the sketch:
+  #include "gauge.h"
+  grayscale.bitmap(0, 0, gauge_width, gauge_pages, gauge_msb, gauge_lsb);
+"""
+
+import argparse
+import sys
+
+
+def read_pgm(path):
+    data = open(path, 'rb').read()
+    tokens = []
+    pos = 0
+    # magic, width, height, maxval, each possibly preceded by comments
+    while len(tokens) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            pos = data.index(b'\n', pos)
+            continue
+        end = pos
+        while not data[end:end + 1].isspace():
+            end += 1
+        tokens.append(data[pos:end])
+        pos = end
+    magic, width, height, maxval = tokens[0], int(tokens[1]), int(tokens[2]), int(tokens[3])
+    if magic == b'P5':
+        pos += 1
+        size = 2 if maxval > 255 else 1
+        values = [int.from_bytes(data[pos + i * size:pos + (i + 1) * size], 'big') for i in range(width * height)]
+    elif magic == b'P2':
+        values = [int(v) for v in data[pos:].split()[:width * height]]
+    else:
+        raise ValueError('not a PGM file')
+    return width, height, [v * 255 // maxval for v in values]
+
+
+def read_image(path):
+    try:
+        return read_pgm(path)
+    except ValueError:
+        pass
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit('%s is not a PGM file, and Pillow is not installed to read it' % path)
+    image = Image.open(path).convert('L')
+    return image.width, image.height, list(image.getdata())
+
+
+def planes(width, height, pixels, invert):
+    pages = (height + 7) // 8
+    msb, lsb = [], []
+    for page in range(pages):
+        for x in range(width):
+            m = l = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y >= height:
+                    continue
+                shade = pixels[y * width + x] >> 6
+                if invert:
+                    shade = 3 - shade
+                m |= (shade >> 1) << bit
+                l |= (shade & 1) << bit
+            msb.append(m)
+            lsb.append(l)
+    return pages, msb, lsb
+
+
+def write_array(out, name, data):
+    out.write('const uint8_t %s [] PROGMEM = {\n' % name)
+    for start in range(0, len(data), 16):
+        out.write('  %s,\n' % ','.join('0x%02x' % b for b in data[start:start + 16]))
+    out.write('};\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Split an image into Tiny4kOLED grayscale bit planes.')
+    parser.add_argument('--name', required=True, help='prefix for the generated arrays')
+    parser.add_argument('--invert', action='store_true', help='treat dark pixels as lit')
+    parser.add_argument('image')
+    args = parser.parse_args()
+
+    width, height, pixels = read_image(args.image)
+    if width > 128 or height > 32:
+        sys.exit('%s is %dx%d, larger than a 128x32 frame' % (args.image, width, height))
+    pages, msb, lsb = planes(width, height, pixels, args.invert)
+
+    out = sys.stdout
+    out.write('// Generated by tools/grayscale.py from %s\n' % args.image)
+    out.write('#define %s_width %d\n' % (args.name, width))
+    out.write('#define %s_pages %d\n' % (args.name, pages))
+    write_array(out, args.name + '_msb', msb)
+    write_array(out, args.name + '_lsb', lsb)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""
+Tiny4kOLED constant string rasteriser.
+
+Renders constant strings in a font ahead of time, writing each one as a
+PROGMEM bitmap in the layout bitmap() expects, so that a static label is
+sent as a single data transaction instead of being looked up glyph by glyph.
+
+usage:
+  python3 rasterise.py --font ../src/font8x16.h --trim \\
+      datacute_label="Datacute" > labels.h
+
+then in the sketch:
+  #include "labels.h"
+  oled.bitmap(32, 0, 32 + datacute_label_width, 0 + datacute_label_pages, datacute_label);
+"""
+
+import argparse
+import sys
+
+from fontsubset import read_font
+
+
+def rasterise(text, bitmap, width, height, first, last):
+    """Returns a list of columns, each a list of height page bytes."""
+    columns = []
+    for c in text:
+        code = ord(c)
+        if not first <= code <= last:
+            sys.exit('character %r is not in the font' % c)
+        glyph = bitmap[(code - first) * width * height:(code - first + 1) * width * height]
+        for x in range(width):
+            columns.append([glyph[page * width + x] for page in range(height)])
+    return columns
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pre-render constant strings for bitmap().')
+    parser.add_argument('--font', required=True, help='font header, e.g. src/font6x8.h')
+    parser.add_argument('--trim', action='store_true', help='remove blank columns from both ends')
+    parser.add_argument('labels', nargs='+', metavar='name=text', help='bitmap name and the string to render')
+    args = parser.parse_args()
+
+    font = read_font(args.font)
+    height = font[2]
+
+    out = sys.stdout
+    out.write('// Generated by tools/rasterise.py from %s\n' % args.font)
+    for label in args.labels:
+        name, sep, text = label.partition('=')
+        if not sep or not name.isidentifier():
+            sys.exit('expected name=text, got %r' % label)
+        columns = rasterise(text, *font)
+        if args.trim:
+            while columns and not any(columns[0]):
+                columns.pop(0)
+            while columns and not any(columns[-1]):
+                columns.pop()
+        if not columns:
+            sys.exit('%s is blank' % name)
+        out.write('\n// "%s", %d columns by %d pages\n' % (text.replace('\\', '\\\\'), len(columns), height))
+        out.write('#define %s_width %d\n' % (name, len(columns)))
+        out.write('#define %s_pages %d\n' % (name, height))
+        out.write('const uint8_t %s [] PROGMEM = {\n' % name)
+        for page in range(height):
+            row = [column[page] for column in columns]
+            for start in range(0, len(row), 16):
+                out.write('  %s,\n' % ','.join('0x%02x' % b for b in row[start:start + 16]))
+        out.write('};\n')
+
+
+if __name__ == '__main__':
+    main()